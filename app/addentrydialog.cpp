@@ -1,4 +1,5 @@
 #include "addentrydialog.h"
+#include "categorytable.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -10,10 +11,18 @@
 #include <QComboBox>
 #include <QCheckBox>
 #include <QDateTimeEdit>
+#include <QDateEdit>
+#include <QMenu>
+#include <QMessageBox>
+#include <algorithm>
 
 static const QColor BG("#0B0B0B");
 static const QColor PANEL("#141414");
 static const QColor TEXT("#EDEDED");
+static const QColor WARN("#F5A623");
+
+// 找空檔往後看幾天
+static const int kFreeSlotDays = 28;
 
 AddEntryDialog::AddEntryDialog(const QDate &selectedDate, QWidget *parent)
     : QDialog(parent), date(selectedDate)
@@ -41,6 +50,7 @@ void AddEntryDialog::buildUi() {
     pages->addWidget(buildExpenseIncomePage(true));  // Income
     pages->addWidget(buildTodoPage());               // Todo
     root->addWidget(pages, 1);
+    root->addWidget(buildRepeatRow());
 
     keypadWidget = buildKeypad();
     root->addWidget(keypadWidget);
@@ -128,7 +138,7 @@ QWidget* AddEntryDialog::buildExpenseIncomePage(bool isIncome) {
     row2->addStretch(1);
 
     QComboBox *cat = new QComboBox(panel);
-    cat->addItems({"飲食","交通","購物","娛樂","日用必需品","醫療","投資","薪水","獎金","零用金","其他"});
+    cat->addItems(CategoryTable::builtins());
     row2->addWidget(cat);
     v->addLayout(row2);
 
@@ -179,12 +189,25 @@ QWidget* AddEntryDialog::buildTodoPage() {
     rowE->addWidget(endDT);
     v->addLayout(rowE);
 
+    conflictLabel = new QLabel(panel);
+    conflictLabel->setObjectName("conflictLabel");
+    conflictLabel->setWordWrap(true);
+    v->addWidget(conflictLabel);
+
+    btnFreeSlot = new QPushButton("找空檔", panel);
+    v->addWidget(btnFreeSlot);
+    connect(btnFreeSlot, &QPushButton::clicked, this, &AddEntryDialog::pickFreeSlot);
+
     auto updateEnabled = [=]{
         bool enable = !allDay->isChecked();
         startDT->setEnabled(enable);
         endDT->setEnabled(enable);
+        btnFreeSlot->setEnabled(enable);
+        updateConflictHint();
     };
     connect(allDay, &QCheckBox::toggled, this, [=]{ updateEnabled(); });
+    connect(startDT, &QDateTimeEdit::dateTimeChanged, this, [=]{ updateConflictHint(); });
+    connect(endDT, &QDateTimeEdit::dateTimeChanged, this, [=]{ updateConflictHint(); });
     updateEnabled();
 
     v->addStretch(1);
@@ -239,6 +262,104 @@ QWidget* AddEntryDialog::buildKeypad() {
     return w;
 }
 
+// ✅ 重複：不重複 / 每天 / 每週 / 每月 / 每年，可選結束日
+QWidget* AddEntryDialog::buildRepeatRow() {
+    auto *w = new QWidget(this);
+    auto *h = new QHBoxLayout(w);
+    h->setContentsMargins(0,0,0,0);
+    h->setSpacing(8);
+
+    repeatBox = new QComboBox(w);
+    repeatBox->addItems({"不重複", "每天", "每週", "每月", "每年"});
+
+    hasUntil = new QCheckBox("結束於", w);
+    untilDate = new QDateEdit(date.addYears(1), w);
+    untilDate->setCalendarPopup(true);
+    untilDate->setMinimumDate(date);
+
+    h->addWidget(new QLabel("重複", w));
+    h->addWidget(repeatBox, 1);
+    h->addWidget(hasUntil);
+    h->addWidget(untilDate);
+
+    auto updateEnabled = [=]{
+        const bool repeat = repeatBox->currentIndex() > 0;
+        hasUntil->setEnabled(repeat);
+        untilDate->setEnabled(repeat && hasUntil->isChecked());
+    };
+    connect(repeatBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [=]{ updateEnabled(); });
+    connect(hasUntil, &QCheckBox::toggled, this, [=]{ updateEnabled(); });
+    updateEnabled();
+
+    return w;
+}
+
+void AddEntryDialog::setDayTodos(const QVector<Todo>& t) {
+    dayTodos = t;
+    updateConflictHint();
+}
+
+// 索引查全部日子；這一天改用記憶體裡的待辦（剛新增的可能還沒寫出）
+QVector<TodoSpan> AddEntryDialog::busyBetween(const QDateTime& from, const QDateTime& to) const {
+    QVector<TodoSpan> busy;
+    for (const TodoSpan &s : TodoIntervals::instance().overlapping(from, to))
+        if (s.recurring || s.day != date) busy.append(s);
+
+    for (const Todo &td : dayTodos) {
+        if (td.allDay || !TodoIntervals::isValidRange(td)) continue;
+        TodoSpan s{ td.start, td.end, date, td.title, false };
+        if (TodoIntervals::overlaps(s, from, to)) busy.append(s);
+    }
+    std::stable_sort(busy.begin(), busy.end(), [](const TodoSpan &a, const TodoSpan &b){
+        return a.start < b.start;
+    });
+    return busy;
+}
+
+void AddEntryDialog::updateConflictHint() {
+    if (!conflictLabel || !startDT || !endDT || !allDay) return;
+
+    if (allDay->isChecked()) {
+        conflictLabel->clear();
+        return;
+    }
+    const QDateTime s = startDT->dateTime();
+    const QDateTime e = endDT->dateTime();
+    if (e < s) {
+        conflictLabel->setText("結束時間早於開始時間");
+        return;
+    }
+
+    QStringList names;
+    for (const TodoSpan &b : busyBetween(s, qMax(e, s.addMSecs(1))))
+        names.append(QString("%1 %2-%3").arg(b.title, b.start.toString("M/d hh:mm"), b.end.toString("hh:mm")));
+    conflictLabel->setText(names.isEmpty() ? QString() : "時間重疊：" + names.join("、"));
+}
+
+// ✅ 依目前長度，從開始時間往後找幾個空檔讓使用者挑
+void AddEntryDialog::pickFreeSlot() {
+    const QDateTime from = startDT->dateTime();
+    int minutes = int(from.secsTo(endDT->dateTime()) / 60);
+    if (minutes <= 0) minutes = 60;
+
+    const QDateTime to = QDateTime(from.date().addDays(kFreeSlotDays), QTime(0, 0));
+    const QVector<TimeSlot> found = TodoIntervals::freeSlotsIn(busyBetween(from, to), from, to, minutes,
+                                                              QTime(9, 0), QTime(18, 0), 5);
+
+    QMenu menu;
+    if (found.isEmpty()) menu.addAction("接下來四週都排滿了")->setEnabled(false);
+    for (const TimeSlot &slot : found) {
+        QAction *a = menu.addAction(QString("%1 %2-%3").arg(slot.start.toString("M/d ddd"),
+                                                           slot.start.toString("hh:mm"),
+                                                           slot.end.toString("hh:mm")));
+        connect(a, &QAction::triggered, this, [=]{
+            startDT->setDateTime(slot.start);
+            endDT->setDateTime(slot.end);
+        });
+    }
+    menu.exec(btnFreeSlot->mapToGlobal(QPoint(0, btnFreeSlot->height())));
+}
+
 void AddEntryDialog::switchPage(Page p) {
     if (!pages) return;
 
@@ -284,7 +405,34 @@ void AddEntryDialog::onSave() {
         td.start = startDT ? startDT->dateTime() : QDateTime(date, QTime(9,0));
         td.end   = endDT   ? endDT->dateTime()   : QDateTime(date, QTime(10,0));
 
-        emit savedTodo(td);
+        // ✅ 時段不合理不存；跟別的待辦重疊先問一聲
+        if (!td.allDay) {
+            if (!TodoIntervals::isValidRange(td)) {
+                QMessageBox::warning(this, "時間錯誤", "結束時間早於開始時間。");
+                return;
+            }
+            const QVector<TodoSpan> busy = busyBetween(td.start, qMax(td.end, td.start.addMSecs(1)));
+            if (!busy.isEmpty()) {
+                QStringList names;
+                for (const TodoSpan &b : busy)
+                    names.append(QString("%1（%2-%3）").arg(b.title, b.start.toString("M/d hh:mm"),
+                                                            b.end.toString("hh:mm")));
+                if (QMessageBox::question(this, "時間重疊",
+                                          "與以下待辦重疊：\n" + names.join("\n") + "\n\n仍要儲存？")
+                        != QMessageBox::Yes)
+                    return;
+            }
+        }
+
+        if (repeatBox && repeatBox->currentIndex() > 0) {
+            RecurrenceRule r = makeRule();
+            r.isTodo = true;
+            r.todo = td;
+            r.start = td.start.date();
+            emit savedRecurring(r);
+        } else {
+            emit savedTodo(td);
+        }
         accept();
         return;
     }
@@ -299,15 +447,30 @@ void AddEntryDialog::onSave() {
 
     AccountItem item;
     item.date = date;
-    item.category = cat->currentText();
+    item.setCategory(cat->currentText());
     item.amount = amount;
-    item.type = currentIsIncome ? "income" : "expense";
+    item.type = currentIsIncome ? EntryType::Income : EntryType::Expense;
     item.note = "";
 
-    emit savedExpenseIncome(item);
+    if (repeatBox && repeatBox->currentIndex() > 0) {
+        RecurrenceRule r = makeRule();
+        r.item = item;
+        emit savedRecurring(r);
+    } else {
+        emit savedExpenseIncome(item);
+    }
     accept();
 }
 
+RecurrenceRule AddEntryDialog::makeRule() const {
+    RecurrenceRule r;
+    r.id = RecurrenceStore::newId();
+    r.freq = RecurrenceRule::Freq(repeatBox->currentIndex() - 1);
+    r.start = date;
+    if (hasUntil->isChecked()) r.until = untilDate->date();
+    return r;
+}
+
 void AddEntryDialog::applyStyle() {
     setStyleSheet(QString(R"(
         QDialog { background: %1; color: %2; }
@@ -322,6 +485,8 @@ void AddEntryDialog::applyStyle() {
         QComboBox { background: %3; border: 1px solid #2A2A2A; border-radius: 10px; padding: 8px; color: %2; }
         QCheckBox { spacing: 8px; }
 
+        QLabel#conflictLabel { color: %4; }
+
         QDateTimeEdit { background: %3; border: 1px solid #2A2A2A; border-radius: 10px; padding: 8px; color: %2; }
-    )").arg(BG.name(), TEXT.name(), PANEL.name()));
+    )").arg(BG.name(), TEXT.name(), PANEL.name(), WARN.name()));
 }
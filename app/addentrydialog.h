@@ -3,6 +3,8 @@
 #include <QDate>
 #include "models.h"
 #include "account.h"
+#include "recurrence.h"
+#include "todointervals.h"
 
 class QLabel;
 class QLineEdit;
@@ -11,6 +13,7 @@ class QStackedWidget;
 class QComboBox;
 class QCheckBox;
 class QDateTimeEdit;
+class QDateEdit;
 
 class AddEntryDialog : public QDialog {
     Q_OBJECT
@@ -18,9 +21,14 @@ public:
     enum Page { Expense=0, Income=1, TodoPage=2 };
     explicit AddEntryDialog(const QDate& selectedDate, QWidget *parent=nullptr);
 
+    // 這天記憶體裡的待辦（可能還在延遲寫入，索引裡的那天以這份為準）
+    void setDayTodos(const QVector<Todo>& t);
+
 signals:
     void savedExpenseIncome(const AccountItem& item);
     void savedTodo(const Todo& td);
+    // 選了重複：只存一條規則，不寫日檔
+    void savedRecurring(const RecurrenceRule& rule);
 
 private slots:
     void onSave();
@@ -34,12 +42,19 @@ private:
     QWidget* buildExpenseIncomePage(bool isIncome);
     QWidget* buildTodoPage();
     QWidget* buildKeypad();
+    QWidget* buildRepeatRow();
 
     void switchPage(Page p);
     void updateDateLabel();
 
     QLineEdit* currentAmountEdit() const;
     QComboBox* currentCategoryBox() const;
+    RecurrenceRule makeRule() const;   // 頻率 / 起訖日，內容由 onSave 補上
+
+    // ✅ 時段衝突 / 空檔
+    QVector<TodoSpan> busyBetween(const QDateTime& from, const QDateTime& to) const;
+    void updateConflictHint();
+    void pickFreeSlot();
 
 private:
     QDate date;
@@ -68,5 +83,12 @@ private:
     QDateTimeEdit *startDT = nullptr;
     QDateTimeEdit *endDT = nullptr;
     QWidget *keypadWidget = nullptr;
-
+    QLabel *conflictLabel = nullptr;
+    QPushButton *btnFreeSlot = nullptr;
+    QVector<Todo> dayTodos;
+
+    // 重複
+    QComboBox *repeatBox = nullptr;
+    QCheckBox *hasUntil = nullptr;
+    QDateEdit *untilDate = nullptr;
 };
@@ -0,0 +1,27 @@
+QT += widgets
+CONFIG += c++17
+TEMPLATE = app
+TARGET = calendar
+
+include(../core/core.pri)
+
+SOURCES += \
+    main.cpp \
+    mainwindow.cpp \
+    dotcalendar.cpp \
+    addentrydialog.cpp \
+    ledgermodel.cpp \
+    todomodel.cpp \
+    dayitemdelegate.cpp \
+    yearview.cpp \
+    balancechart.cpp
+
+HEADERS += \
+    mainwindow.h \
+    dotcalendar.h \
+    addentrydialog.h \
+    ledgermodel.h \
+    todomodel.h \
+    dayitemdelegate.h \
+    yearview.h \
+    balancechart.h
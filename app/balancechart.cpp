@@ -0,0 +1,86 @@
+#include "balancechart.h"
+#include "balanceindex.h"
+
+#include <QPainter>
+#include <QPainterPath>
+
+static const QColor PANEL("#141414");
+static const QColor TEXT("#EDEDED");
+static const QColor DIM("#555555");
+static const QColor ACCENT("#F5A623");
+
+static const int MARGIN = 12;
+static const int LABEL_H = 18;
+
+BalanceChart::BalanceChart(QWidget *parent)
+    : QWidget(parent)
+{
+    setMinimumSize(320, 200);
+}
+
+void BalanceChart::setRange(const QDate &f, const QDate &t) {
+    from = f;
+    to = t;
+    requery();
+    update();
+}
+
+void BalanceChart::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    requery();
+}
+
+// 一個像素欄一個點，寬度變了才重查
+void BalanceChart::requery() {
+    const int columns = qMax(2, width() - MARGIN * 2);
+    points = BalanceIndex::instance().series(from, to, columns);
+}
+
+void BalanceChart::paintEvent(QPaintEvent *) {
+    QPainter p(this);
+    p.fillRect(rect(), PANEL);
+    if (points.size() < 2) {
+        p.setPen(DIM);
+        p.drawText(rect(), Qt::AlignCenter, "沒有資料");
+        return;
+    }
+
+    qint64 lo = points.first().second, hi = lo;
+    for (const auto &pt : points) {
+        lo = qMin(lo, pt.second);
+        hi = qMax(hi, pt.second);
+    }
+    const qint64 maxBalance = hi;   // 標籤用實際最高；下面的 lo / hi 只是刻度範圍
+    lo = qMin<qint64>(lo, 0);
+    hi = qMax<qint64>(hi, 0);
+    if (hi == lo) hi = lo + 1;
+
+    const QRectF plot(MARGIN, MARGIN + LABEL_H, width() - MARGIN * 2, height() - MARGIN * 2 - LABEL_H * 2);
+    auto yOf = [&](qint64 v){ return plot.bottom() - (v - lo) * plot.height() / double(hi - lo); };
+
+    // 0 基準線
+    p.setPen(QPen(DIM, 1, Qt::DashLine));
+    p.drawLine(QPointF(plot.left(), yOf(0)), QPointF(plot.right(), yOf(0)));
+
+    QPainterPath path;
+    for (int i = 0; i < points.size(); ++i) {
+        const QPointF pt(plot.left() + i * plot.width() / (points.size() - 1), yOf(points[i].second));
+        if (i == 0) path.moveTo(pt);
+        else path.lineTo(pt);
+    }
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setPen(QPen(ACCENT, 2));
+    p.drawPath(path);
+    p.setRenderHint(QPainter::Antialiasing, false);
+
+    p.setPen(TEXT);
+    p.drawText(QRectF(MARGIN, MARGIN, plot.width(), LABEL_H), Qt::AlignLeft | Qt::AlignVCenter,
+               QString("最高 %1").arg(maxBalance));
+    p.drawText(QRectF(MARGIN, MARGIN, plot.width(), LABEL_H), Qt::AlignRight | Qt::AlignVCenter,
+               QString("目前 %1").arg(points.last().second));
+
+    p.setPen(DIM);
+    const QRectF axis(MARGIN, plot.bottom() + 2, plot.width(), LABEL_H);
+    p.drawText(axis, Qt::AlignLeft | Qt::AlignVCenter, points.first().first.toString("yyyy/MM/dd"));
+    p.drawText(axis, Qt::AlignRight | Qt::AlignVCenter, points.last().first.toString("yyyy/MM/dd"));
+}
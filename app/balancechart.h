@@ -0,0 +1,25 @@
+#pragma once
+#include <QWidget>
+#include <QDate>
+#include <QVector>
+#include <QPair>
+
+// ✅ 累計餘額折線圖：每個像素欄查一次 BalanceIndex（O(log n)），不讀檔
+class BalanceChart : public QWidget {
+    Q_OBJECT
+public:
+    explicit BalanceChart(QWidget *parent = nullptr);
+
+    void setRange(const QDate& from, const QDate& to);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    void requery();
+
+    QDate from;
+    QDate to;
+    QVector<QPair<QDate, qint64>> points;
+};
@@ -0,0 +1,113 @@
+#include "dayitemdelegate.h"
+#include "ledgermodel.h"
+#include "todomodel.h"
+
+#include <QPainter>
+#include <QMouseEvent>
+#include <QKeyEvent>
+
+static const QColor TEXT("#EDEDED");
+static const QColor DIM("#9A9A9A");
+static const QColor LINE("#1E1E1E");
+static const QColor SELECTED(255,255,255,24);
+
+static const int PAD = 10;
+static const int CHECK = 18;
+
+static_assert(int(LedgerModel::TitleRole) == int(TodoModel::TitleRole)
+              && int(LedgerModel::DetailRole) == int(TodoModel::DetailRole),
+              "DayItemDelegate 讀兩個 model 的同一組 role");
+
+DayItemDelegate::DayItemDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+QRect DayItemDelegate::checkRect(const QRect &r) const {
+    return QRect(r.left() + PAD, r.center().y() - CHECK/2, CHECK, CHECK);
+}
+
+QSize DayItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &) const {
+    // 每列一樣高：兩行字 + 上下留白
+    return QSize(option.rect.width(), option.fontMetrics.height() * 2 + 4 + PAD * 2);
+}
+
+void DayItemDelegate::paint(QPainter *p, const QStyleOptionViewItem &option,
+                            const QModelIndex &index) const {
+    p->save();
+
+    const QRect r = option.rect;
+    if (option.state & QStyle::State_Selected)
+        p->fillRect(r, SELECTED);
+
+    int textLeft = r.left() + PAD;
+
+    // 勾選框（只有待辦有 CheckStateRole）
+    const QVariant check = index.data(Qt::CheckStateRole);
+    if (check.isValid()) {
+        const QRect box = checkRect(r);
+        const bool done = (check.toInt() == Qt::Checked);
+
+        p->setRenderHint(QPainter::Antialiasing, true);
+        p->setPen(QPen(done ? TEXT : DIM, 1.5));
+        p->setBrush(done ? TEXT : Qt::transparent);
+        p->drawRoundedRect(box, 4, 4);
+
+        if (done) {
+            p->setPen(QPen(QColor("#111111"), 2));
+            p->drawLine(QPoint(box.left() + 4, box.center().y()), QPoint(box.left() + 8, box.bottom() - 4));
+            p->drawLine(QPoint(box.left() + 8, box.bottom() - 4), QPoint(box.right() - 3, box.top() + 4));
+        }
+        p->setRenderHint(QPainter::Antialiasing, false);
+
+        textLeft = box.right() + PAD;
+    }
+
+    const int lineH = option.fontMetrics.height();
+    const QRect titleRect(textLeft, r.top() + PAD, r.right() - PAD - textLeft, lineH);
+    const QRect detailRect(textLeft, titleRect.bottom() + 4, titleRect.width(), lineH);
+
+    const QString title = index.data(LedgerModel::TitleRole).toString();
+    const QString detail = index.data(LedgerModel::DetailRole).toString();
+
+    p->setPen(TEXT);
+    p->drawText(titleRect, Qt::AlignLeft | Qt::AlignVCenter,
+                option.fontMetrics.elidedText(title, Qt::ElideRight, titleRect.width()));
+    p->setPen(DIM);
+    p->drawText(detailRect, Qt::AlignLeft | Qt::AlignVCenter,
+                option.fontMetrics.elidedText(detail, Qt::ElideRight, detailRect.width()));
+
+    // 分隔線
+    p->setPen(LINE);
+    p->drawLine(r.bottomLeft(), r.bottomRight());
+
+    p->restore();
+}
+
+// ✅ 點勾選框（或按空白鍵）切換完成狀態
+bool DayItemDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                  const QStyleOptionViewItem &option, const QModelIndex &index) {
+    // 沒有勾選狀態的列（記帳、搜尋結果）不處理
+    if (!(index.flags() & Qt::ItemIsUserCheckable) || !index.data(Qt::CheckStateRole).isValid())
+        return false;
+
+    if (event->type() == QEvent::MouseButtonRelease || event->type() == QEvent::MouseButtonDblClick) {
+        auto *me = static_cast<QMouseEvent*>(event);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        const QPoint pos = me->position().toPoint();
+#else
+        const QPoint pos = me->pos();
+#endif
+        if (me->button() != Qt::LeftButton || !checkRect(option.rect).contains(pos))
+            return false;
+        if (event->type() == QEvent::MouseButtonDblClick) return true;   // 吃掉，避免觸發兩次
+    } else if (event->type() == QEvent::KeyPress) {
+        auto *ke = static_cast<QKeyEvent*>(event);
+        if (ke->key() != Qt::Key_Space && ke->key() != Qt::Key_Select) return false;
+    } else {
+        return false;
+    }
+
+    const bool done = (index.data(Qt::CheckStateRole).toInt() == Qt::Checked);
+    return model->setData(index, done ? Qt::Unchecked : Qt::Checked, Qt::CheckStateRole);
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <QStyledItemDelegate>
+
+// ✅ 記帳 / 待辦清單共用的兩行項目：標題 + 說明，可勾選的項目左邊畫勾選框
+// 高度固定，搭配 QListView::setUniformItemSizes 不必逐列量測
+class DayItemDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+public:
+    explicit DayItemDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+protected:
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+private:
+    QRect checkRect(const QRect &itemRect) const;
+};
@@ -0,0 +1,242 @@
+#include "dotcalendar.h"
+#include <QPainter>
+#include <QPixmap>
+#include <QPixmapCache>
+#include <QResizeEvent>
+#include <QTimer>
+#include <QDebug>
+
+#include "trace.h"
+
+static const QColor BG("#0B0B0B");
+static const QColor TEXT("#EDEDED");
+static const QColor DIM("#555555");
+static const QColor ACCENT("#F5A623");        // 今天橘色
+static const QColor SELECTED(255,255,255,40); // ✅ 淺灰半透明
+
+DotCalendar::DotCalendar(QWidget *parent)
+    : QCalendarWidget(parent),
+    chosen(QDate::currentDate()),
+    today(QDate::currentDate())
+{
+    setVerticalHeaderFormat(QCalendarWidget::NoVerticalHeader);
+    setGridVisible(false);
+    setNavigationBarVisible(false);
+    setFirstDayOfWeek(Qt::Sunday);
+
+    connect(this, &QCalendarWidget::clicked, this, [=](const QDate &d){
+        setChosenDate(d);
+    });
+
+    connect(this, &QCalendarWidget::currentPageChanged, this, [=]{
+        beginFrame("month");
+    });
+
+    midnightTimer = new QTimer(this);
+    midnightTimer->setSingleShot(true);
+    connect(midnightTimer, &QTimer::timeout, this, [=]{
+        const QDate old = today;
+        today = QDate::currentDate();
+        updateCell(old);
+        updateCell(today);
+        scheduleMidnight();
+    });
+    scheduleMidnight();
+
+    QFont f = font();
+    f.setPointSize(12);
+    setFont(f);
+}
+
+DotCalendar::~DotCalendar() {
+    for (auto it = frameStats.constBegin(); it != frameStats.constEnd(); ++it) {
+        if (it->frames == 0) continue;
+        qInfo().noquote() << QString("calendar: %1 %2 frames, avg %3 ms, max %4 ms, %5 cells (%6 rendered)")
+                                 .arg(it.key())
+                                 .arg(it->frames)
+                                 .arg(it->totalMs / it->frames, 0, 'f', 2)
+                                 .arg(it->maxMs, 0, 'f', 2)
+                                 .arg(it->cells)
+                                 .arg(it->misses);
+    }
+}
+
+void DotCalendar::scheduleMidnight() {
+    const QDateTime now = QDateTime::currentDateTime();
+    const qint64 ms = now.msecsTo(QDateTime(now.date().addDays(1), QTime(0, 0)));
+    midnightTimer->start(int(qBound<qint64>(1000, ms + 1000, 24 * 3600 * 1000)));
+}
+
+void DotCalendar::setMarkedDates(const QSet<QDate> &dates) {
+    // 新舊兩組的差集才需要重畫
+    for (const QDate &d : marked)
+        if (!dates.contains(d)) updateCell(d);
+    for (const QDate &d : dates)
+        if (!marked.contains(d)) updateCell(d);
+    marked = dates;
+}
+
+QDate DotCalendar::chosenDate() const {
+    return chosen.isValid() ? chosen : QDate::currentDate();
+}
+
+void DotCalendar::setChosenDate(const QDate &d) {
+    if (d == chosen) return;
+    const QDate old = chosen;
+    chosen = d;
+    if (old.isValid()) updateCell(old);
+    updateCell(d);
+}
+
+QColor DotCalendar::heatColor(int level) {
+    QColor c = ACCENT;
+    c.setAlpha(level <= 0 ? 0 : 30 + level * 50);
+    return c;
+}
+
+void DotCalendar::setHeatmapEnabled(bool on) {
+    if (heatmap == on) return;
+    heatmap = on;
+    updateCells();
+}
+
+void DotCalendar::setDailyTotals(const DailyTotals &t) {
+    totals.insert(t.year(), t);
+    if (heatmap) updateCells();
+}
+
+void DotCalendar::setDayTotals(const QDate &d, double income, double expense) {
+    auto it = totals.find(d.year());
+    if (it == totals.end()) return;   // 那年還沒載入，載入時自然是新的
+
+    const bool rescaled = it->setDay(d, income, expense);
+    if (!heatmap) return;
+    if (rescaled) updateCells();
+    else updateCell(d);
+}
+
+void DotCalendar::resizeEvent(QResizeEvent *event) {
+    beginFrame("resize");
+    QCalendarWidget::resizeEvent(event);
+}
+
+void DotCalendar::beginFrame(const QString &reason) const {
+    frameReason = reason;
+}
+
+void DotCalendar::endFrame() const {
+    const double ms = frameTimer.nsecsElapsed() / 1e6;
+    if (Trace::enabled()) {
+        Trace &t = Trace::instance();
+        const qint64 us = frameTimer.nsecsElapsed() / 1000;
+        t.complete("DotCalendar::frame", "paint", t.nowUs() - us, us);
+        t.count("paint.cells", cellsPainted);
+        t.count("paint.cacheMisses", cacheMisses);
+    }
+    FrameStats &s = frameStats[frameReason.isEmpty() ? QStringLiteral("update") : frameReason];
+    s.frames++;
+    s.totalMs += ms;
+    s.maxMs = qMax(s.maxMs, ms);
+    s.cells += cellsPainted;
+    s.misses += cacheMisses;
+
+    frameOpen = false;
+    frameReason.clear();
+    cellsPainted = 0;
+    cacheMisses = 0;
+}
+
+void DotCalendar::paintCell(QPainter *p, const QRect &r, QDate d) const {
+    TRACE_SCOPE_CAT("DotCalendar::paintCell", "paint");
+    if (!frameOpen) {
+        frameOpen = true;
+        frameTimer.start();
+        QTimer::singleShot(0, this, [this]{ endFrame(); });
+    }
+    cellsPainted++;
+
+    const QDate sel = chosen.isValid() ? chosen : today;
+
+    int state = 0;
+    if (d.month() == monthShown() && d.year() == yearShown()) state |= InMonth;
+    if (d == today) state |= Today;
+    else if (d == sel) state |= Chosen;
+    if (marked.contains(d)) state |= Marked;
+
+    if (heatmap && (state & InMonth)) {
+        auto it = totals.constFind(d.year());
+        if (it != totals.constEnd())
+            state |= it->level(d, HeatLevels) << HeatShift;
+    }
+
+    // ✅ 同一個日數、狀態、大小畫出來都一樣：先查快取
+    // 鍵值壓成一個整數再轉字串，每格只配置一次；dpr 取到 0.01
+    const qreal dpr = p->device() ? p->device()->devicePixelRatioF() : 1.0;
+    const quint64 packed = quint64(d.day())                          // 5 bits
+                         | quint64(state & 0xFF) << 5                 // 8 bits
+                         | quint64(r.width() & 0xFFF) << 13           // 12 bits
+                         | quint64(r.height() & 0xFFF) << 25          // 12 bits
+                         | quint64(qRound(dpr * 100) & 0x3FF) << 37;  // 10 bits
+    const QString key = QLatin1String("dotcal/") + QString::number(packed);
+
+    QPixmap pm;
+    if (!QPixmapCache::find(key, &pm)) {
+        cacheMisses++;
+        pm = QPixmap(r.size() * dpr);
+        pm.setDevicePixelRatio(dpr);
+
+        QPainter cp(&pm);
+        cp.setFont(p->font());
+        cp.setRenderHints(p->renderHints());
+        renderCell(&cp, QRect(QPoint(0, 0), r.size()), d.day(), state);
+        cp.end();
+
+        QPixmapCache::insert(key, pm);
+    }
+    p->drawPixmap(r.topLeft(), pm);
+}
+
+void DotCalendar::renderCell(QPainter *p, const QRect &r, int day, int state) const {
+    // 背景
+    p->setPen(Qt::NoPen);
+    p->setBrush(BG);
+    p->drawRect(r);
+
+    const bool isToday = state & Today;
+    const bool isChosen = state & Chosen;
+
+    auto drawPill = [&](const QColor& c){
+        QRect pill = r.adjusted(int(r.width()*0.20), int(r.height()*0.18),
+                                -int(r.width()*0.20), -int(r.height()*0.18));
+        p->setBrush(c);
+        p->setPen(Qt::NoPen);
+        p->drawRoundedRect(pill, pill.height()/2.0, pill.height()/2.0);
+    };
+
+    // 熱度：整格淡淡上色，越花越深
+    const int heat = state >> HeatShift;
+    if (heat > 0) {
+        p->setBrush(heatColor(heat));
+        p->drawRoundedRect(r.adjusted(2, 2, -2, -2), 6, 6);
+    }
+
+    // 今天橘色；選到別天灰色
+    if (isToday) drawPill(ACCENT);
+    else if (isChosen) drawPill(SELECTED);
+
+    // 文字顏色
+    if (!(state & InMonth)) p->setPen(DIM);
+    else if (isToday || isChosen) p->setPen(Qt::white);
+    else p->setPen(TEXT);
+
+    p->drawText(r.adjusted(0, -2, 0, 0), Qt::AlignCenter, QString::number(day));
+
+    // 白點：當天有「記帳或待辦」就顯示
+    if (state & Marked) {
+        p->setBrush(TEXT);
+        p->setPen(Qt::NoPen);
+        QPoint center(r.center().x(), r.bottom() - int(r.height()*0.18));
+        int rad = qMax(2, r.width()/18);
+        p->drawEllipse(center, rad, rad);
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <QCalendarWidget>
+#include <QSet>
+#include <QDate>
+#include <QHash>
+#include <QElapsedTimer>
+
+#include "dailytotals.h"
+
+class QTimer;
+
+class DotCalendar : public QCalendarWidget {
+    Q_OBJECT
+public:
+    explicit DotCalendar(QWidget *parent = nullptr);
+    ~DotCalendar() override;
+
+    // 只重畫白點有變的格子
+    void setMarkedDates(const QSet<QDate>& dates);
+
+    QDate chosenDate() const;
+    void setChosenDate(const QDate& d);
+
+    // ✅ 熱度圖：依每日支出把格子上色，數字來自 DailyTotals
+    static const int HeatLevels = 4;
+    static QColor heatColor(int level);
+
+    void setHeatmapEnabled(bool on);
+    bool heatmapEnabled() const { return heatmap; }
+
+    bool hasDailyTotals(int year) const { return totals.contains(year); }
+    void setDailyTotals(const DailyTotals& t);
+    // 存檔後更新單日；分級基準沒變就只重畫那一格
+    void setDayTotals(const QDate& d, double income, double expense);
+
+protected:
+    void paintCell(QPainter *painter, const QRect &rect, QDate date) const override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    // ✅ 每格的外觀只由這幾個狀態決定，畫好的結果放進 QPixmapCache
+    enum CellState { InMonth = 1, Today = 2, Chosen = 4, Marked = 8 };
+    static const int HeatShift = 4;     // 熱度等級放在狀態旗標上面幾個位元
+
+    void renderCell(QPainter *p, const QRect &r, int day, int state) const;
+    void scheduleMidnight();
+
+    void beginFrame(const QString &reason) const;
+    void endFrame() const;
+
+    QSet<QDate> marked;
+
+    bool heatmap = false;
+    QHash<int, DailyTotals> totals;
+
+    // 今天橘色，選到其他日期灰色
+    QDate chosen;
+    QDate today;            // 跨午夜時由 midnightTimer 更新，不必每格都查系統時間
+    QTimer *midnightTimer = nullptr;
+
+    // ✅ 畫面時間量測：一次重畫 = 第一格開始到事件迴圈回來
+    struct FrameStats {
+        int frames = 0;
+        double totalMs = 0;
+        double maxMs = 0;
+        int cells = 0;
+        int misses = 0;     // 快取沒命中、真的重畫的格子
+    };
+    mutable QHash<QString, FrameStats> frameStats;
+    mutable QElapsedTimer frameTimer;
+    mutable bool frameOpen = false;
+    mutable QString frameReason;
+    mutable int cellsPainted = 0;
+    mutable int cacheMisses = 0;
+};
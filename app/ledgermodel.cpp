@@ -0,0 +1,132 @@
+#include "ledgermodel.h"
+
+LedgerModel::LedgerModel(Account *account, QObject *parent)
+    : QAbstractListModel(parent),
+    account(account)
+{
+}
+
+int LedgerModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : realRows() + recurring.size();
+}
+
+QVariant LedgerModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount()) return QVariant();
+
+    const int n = realRows();
+    const bool virt = index.row() >= n;
+    const AccountItem &item = virt ? recurring.at(index.row() - n).item : account->getItems().at(index.row());
+    const QString sign = (item.type == EntryType::Income) ? "收入" : "支出";
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return QString("%1\n%2  %3").arg(item.category()).arg(sign).arg(item.amount);
+    case TitleRole:
+        return virt ? QString("↻ %1").arg(item.category()) : item.category();
+    case DetailRole:
+        return item.note.isEmpty() ? QString("%1  %2").arg(sign).arg(item.amount)
+                                   : QString("%1  %2  %3").arg(sign).arg(item.amount).arg(item.note);
+    case AmountRole:
+        return item.amount;
+    case TypeRole:
+        return int(item.type);
+    case RecurringRole:
+        return virt ? recurring.at(index.row() - n).ruleId : QString();
+    default:
+        return QVariant();
+    }
+}
+
+void LedgerModel::setAccount(const Account &a, const QVector<RecurringLedger> &r) {
+    beginResetModel();
+    *account = a;
+    recurring = r;
+    endResetModel();
+}
+
+void LedgerModel::setRecurring(const QVector<RecurringLedger> &r) {
+    const int n = realRows();
+    if (!recurring.isEmpty()) {
+        beginRemoveRows(QModelIndex(), n, n + recurring.size() - 1);
+        recurring.clear();
+        endRemoveRows();
+    }
+    if (!r.isEmpty()) {
+        beginInsertRows(QModelIndex(), n, n + r.size() - 1);
+        recurring = r;
+        endInsertRows();
+    }
+}
+
+QString LedgerModel::ruleIdAt(int row) const {
+    const int i = row - realRows();
+    return (i >= 0 && i < recurring.size()) ? recurring.at(i).ruleId : QString();
+}
+
+bool LedgerModel::removeRecurringAt(int row) {
+    const int i = row - realRows();
+    if (i < 0 || i >= recurring.size()) return false;
+    const AccountItem old = recurring.at(i).item;
+    beginRemoveRows(QModelIndex(), row, row);
+    recurring.removeAt(i);
+    endRemoveRows();
+    emitDelta(old, -1);
+    return true;
+}
+
+double LedgerModel::dailyIncome() const {
+    double sum = account->dailyIncome();
+    for (const auto &r : recurring)
+        if (r.item.type == EntryType::Income) sum += r.item.amount;
+    return sum;
+}
+
+double LedgerModel::dailyExpense() const {
+    double sum = account->dailyExpense();
+    for (const auto &r : recurring)
+        if (r.item.type == EntryType::Expense) sum += r.item.amount;
+    return sum;
+}
+
+void LedgerModel::emitDelta(const AccountItem &item, double sign) {
+    if (item.type == EntryType::Income) emit totalsDelta(sign * item.amount, 0);
+    else if (item.type == EntryType::Expense) emit totalsDelta(0, sign * item.amount);
+}
+
+void LedgerModel::addItem(const AccountItem &item) {
+    const int row = realRows();   // 插在虛擬列前面
+    beginInsertRows(QModelIndex(), row, row);
+    account->addItem(item);
+    endInsertRows();
+    emitDelta(item, +1);
+}
+
+bool LedgerModel::insertAt(int row, const AccountItem &item) {
+    if (row < 0 || row > realRows()) return false;
+    beginInsertRows(QModelIndex(), row, row);
+    account->insertAt(row, item);
+    endInsertRows();
+    emitDelta(item, +1);
+    return true;
+}
+
+bool LedgerModel::removeAt(int row) {
+    if (row < 0 || row >= account->getItems().size()) return false;
+    const AccountItem old = account->getItems().at(row);
+    beginRemoveRows(QModelIndex(), row, row);
+    account->removeAt(row);
+    endRemoveRows();
+    emitDelta(old, -1);
+    return true;
+}
+
+bool LedgerModel::updateAt(int row, const AccountItem &item) {
+    if (row < 0 || row >= account->getItems().size()) return false;
+    const AccountItem old = account->getItems().at(row);
+    if (!account->updateAt(row, item)) return false;
+    const QModelIndex i = index(row);
+    emit dataChanged(i, i);
+    emitDelta(old, -1);
+    emitDelta(item, +1);
+    return true;
+}
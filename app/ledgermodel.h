@@ -0,0 +1,48 @@
+#pragma once
+#include <QAbstractListModel>
+
+#include "account.h"
+#include "recurrence.h"
+
+// ✅ 當天記帳清單：直接讀 MainWindow 的 Account，不複製資料
+// 新增 / 刪除 / 修改都經過這裡，只通知變動的那一列
+// 週期規則展開的那幾筆接在真正的記帳後面（虛擬列，不寫進日檔）
+class LedgerModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    enum Roles { TitleRole = Qt::UserRole + 1, DetailRole, AmountRole, TypeRole, RecurringRole };
+
+    explicit LedgerModel(Account *account, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // 換了一天：整個 Account 換掉，只有這裡整批重設
+    void setAccount(const Account &a, const QVector<RecurringLedger> &r = {});
+    // 規則新增 / 刪除後只換虛擬列；月統計另外重算，不發 totalsDelta
+    void setRecurring(const QVector<RecurringLedger> &r);
+
+    int realRows() const { return account->getItems().size(); }
+    QString ruleIdAt(int row) const;   // 不是虛擬列就回傳空字串
+    // 略過這一次：拿掉那一列並發出差額
+    bool removeRecurringAt(int row);
+
+    // 當天合計（含虛擬列）
+    double dailyIncome() const;
+    double dailyExpense() const;
+
+    void addItem(const AccountItem &item);
+    bool insertAt(int row, const AccountItem &item);   // 復原刪除：放回原位
+    bool removeAt(int row);
+    bool updateAt(int row, const AccountItem &item);
+
+signals:
+    // 新增 / 修改 / 刪除造成的收支差額（本月累計用）
+    void totalsDelta(double income, double expense);
+
+private:
+    void emitDelta(const AccountItem &item, double sign);
+
+    Account *account;
+    QVector<RecurringLedger> recurring;
+};
@@ -0,0 +1,33 @@
+#include <QApplication>
+#include <QElapsedTimer>
+#include "mainwindow.h"
+#include "journal.h"
+#include "startupsnapshot.h"
+#include "trace.h"
+
+int main(int argc, char *argv[]) {
+    QElapsedTimer startup;   // 第一個畫面的時間從這裡算
+    startup.start();
+
+    QApplication a(argc, argv);
+
+    int ret = 0;
+    StartupSnapshot snapshot;
+    {
+        MainWindow w;
+        w.trackFirstPaint(startup);
+        w.show();
+        ret = a.exec();
+        snapshot = w.startupSnapshot();
+    }   // MainWindow 解構時會等背景存檔寫完
+
+    // 背景壓縮中的日誌要等它寫完再離開
+    if (Journal::enabled()) Journal::instance().waitForCompaction();
+
+    // ✅ 全部寫完才記快照，來源檔的修改時間才是最終的
+    if (snapshot.isValid()) snapshot.save();
+
+    // CALENDAR_TRACE：寫 trace 檔與摘要
+    Trace::instance().finish();
+    return ret;
+}
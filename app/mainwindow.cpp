@@ -0,0 +1,1048 @@
+#include "mainwindow.h"
+#include "dotcalendar.h"
+#include "yearview.h"
+#include "balancechart.h"
+#include "balanceindex.h"
+#include "budgettracker.h"
+#include "addentrydialog.h"
+#include "ledgerquery.h"
+#include "datepresence.h"
+#include "todostore.h"
+#include "journal.h"
+#include "storageservice.h"
+#include "ledgermodel.h"
+#include "todomodel.h"
+#include "dayitemdelegate.h"
+#include "recurrence.h"
+#include "trace.h"
+
+#include <QApplication>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QListView>
+#include <QListWidget>
+#include <QLineEdit>
+#include <QTimer>
+#include <QToolButton>
+#include <QFrame>
+#include <QFile>
+
+
+#include <QMessageBox>
+#include <QInputDialog>
+#include <QMenu>
+#include <QProgressBar>
+#include <QStackedWidget>
+#include <QDialog>
+#include <QComboBox>
+#include <QShortcut>
+#include <QKeySequence>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDir>
+#include <QDebug>
+
+static const QColor BG("#0B0B0B");
+static const QColor PANEL("#141414");
+static const QColor TEXT("#EDEDED");
+static const QColor DIM("#9A9A9A");
+static const QColor ACCENT("#F5A623");
+
+static const int kHitTodoRole = Qt::UserRole + 10;
+
+// 預讀快取的 key
+static int monthKey(int y, int m){
+    return y * 12 + m - 1;
+}
+
+static QString monthTitleZh(int y, int m){
+    return QString("%1年%2月").arg(y).arg(m);
+}
+
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent)
+{
+    startClock.start();
+    setWindowTitle("Calendar Mock");
+    setMinimumSize(390, 780);
+
+    auto *root = new QWidget(this);
+    auto *v = new QVBoxLayout(root);
+    v->setContentsMargins(14,14,14,14);
+    v->setSpacing(10);
+
+    v->addWidget(buildTopTitle());
+    v->addWidget(buildMonthBar());
+
+    cal = new DotCalendar(this);
+    yearView = new YearView(this);
+
+    calStack = new QStackedWidget(this);
+    calStack->addWidget(cal);
+    calStack->addWidget(yearView);
+    v->addWidget(calStack, 1);
+
+    v->addWidget(buildListPanel(), 0);
+    v->addWidget(buildBottomBar(), 0);
+
+    setCentralWidget(root);
+    applyStyle();
+    root->installEventFilter(this);   // 第一個 Paint 事件 = 第一個畫面
+
+    // ✅ 暖啟動：來源檔都沒變就先用上次離開時的快照，資料夾等第一個畫面之後才列
+    StartupSnapshot snap;
+    warmStart = StartupSnapshot::load(QDate::currentDate(), snap);
+
+    presence = new DatePresence("data", this, false);
+    connect(presence, &DatePresence::changed, this, [=]{ refreshCalendarMarks(); });
+    // 外部（例如 calendar-cli import）改了日檔：月份快取作廢，正在看的那天重讀
+    connect(presence, &DatePresence::daysChangedOnDisk, this, [=](const QVector<QDate> &dates){
+        bool shownMonth = false;
+        for (const QDate &d : dates) {
+            invalidateMonth(d);
+            if (d.year() == currentDate.year() && d.month() == currentDate.month()) shownMonth = true;
+        }
+        if (dayLoading) return;
+        if (dates.contains(currentDate)) loadDay(currentDate);
+        if (shownMonth) refreshMonthSummary(currentDate);
+    });
+
+    // ✅ 讀寫都交給背景執行緒，結果回來再更新畫面
+    storage = new StorageService(this);
+
+    // ✅ 本月累計：月統計回來當基準，之後增刪只加減差額；跨過門檻才提醒
+    budget = new BudgetTracker(this);
+    connect(budget, &BudgetTracker::totalsChanged, this, [=]{ updateBudgetView(); });
+    connect(budget, &BudgetTracker::thresholdCrossed, this, [=](int pct, double expense, double b){
+        QMessageBox::warning(this, "預算提醒",
+                             QString("本月支出已達 %1 / %2（%3%）").arg(expense).arg(b).arg(pct));
+    });
+    connect(ledgerModel, &LedgerModel::totalsDelta, this, [=](double income, double expense){
+        budget->addDelta(currentDate, income, expense);
+    });
+
+    connect(storage, &StorageService::dayLoaded, this,
+            [=](const QDate &d, const Account &a, const QVector<Todo> &t, const QVector<bool> &done){
+        if (d != currentDate) return;
+
+        // 週期規則只存在記憶體，這天有展開的就接在後面
+        ledgerModel->setAccount(a, RecurrenceStore::instance().ledgerOn(d));
+        todoModel->setTodos(t, done, RecurrenceStore::instance().todosOn(d));
+        budget->setBudget(account.getMonthlyBudget());
+        todoOps.clear();
+        setDayLoading(false);
+
+        refreshDaySum();
+
+        // 為了復原別天的編輯才跳過來的：讀完就套用
+        if (pendingStep && d == pendingStepDate) {
+            const bool undo = (pendingStep == 1);
+            pendingStep = 0;
+            if (undo ? history.canUndo() && history.nextUndo().date == d
+                     : history.canRedo() && history.nextRedo().date == d)
+                stepHistory(undo);
+        }
+    });
+
+    connect(storage, &StorageService::monthPrefetched, this, [=](int y, int m, int epoch, const MonthPrefetch &data){
+        if (epoch != monthCacheEpoch) return;   // 發出這次預讀之後有存檔或規則變動，可能是舊的
+        cacheMonth(y, m, data);
+    });
+
+    connect(storage, &StorageService::monthLoaded, this, [=](int y, int m, const RangeTotals &t){
+        if (QDate(y, m, 1) == budget->month()) monthTotalsReady = true;
+        budget->setBaseline(y, m, t.income, t.expense);
+    });
+
+    // ✅ 熱度圖 / 年度總覽都吃同一份每日收支索引
+    connect(storage, &StorageService::yearLoaded, this, [=](int, const DailyTotals &t){
+        cal->setDailyTotals(t);
+        yearView->setDailyTotals(t);
+    });
+    connect(storage, &StorageService::searchResults, this,
+            [=](const QString &query, const QVector<SearchHit> &hits){
+        if (query != searchBox->text()) return;   // 已經改查別的了
+
+        searchList->clear();
+        for (const auto &h : hits) {
+            auto *it = new QListWidgetItem(searchList);
+            it->setData(LedgerModel::TitleRole, QString("%1 · %2")
+                                                    .arg(h.date.toString("yyyy/MM/dd"))
+                                                    .arg(h.todo ? "待辦" : "記帳"));
+            it->setData(LedgerModel::DetailRole, h.snippet);
+            it->setData(Qt::UserRole, h.date);
+            it->setData(kHitTodoRole, h.todo);
+            it->setFlags(it->flags() & ~Qt::ItemIsUserCheckable);   // 共用待辦的 delegate，但搜尋結果不能勾
+        }
+        if (hits.isEmpty()) {
+            auto *it = new QListWidgetItem(searchList);
+            it->setData(LedgerModel::TitleRole, "沒有符合的結果");
+            it->setData(LedgerModel::DetailRole, query);
+            it->setFlags(it->flags() & ~Qt::ItemIsUserCheckable);
+        }
+    });
+
+    connect(storage, &StorageService::balanceIndexReady, this, [=]{ showBalanceChart(); });
+    connect(yearView, &YearView::yearNeeded, this, [=](int y){ storage->requestYear(y); });
+    connect(yearView, &YearView::dateClicked, this, [=](const QDate &d){
+        btnYear->setChecked(false);
+        cal->setCurrentPage(d.year(), d.month());
+        cal->setChosenDate(d);
+        loadDay(d);
+        refreshMonthSummary(d);
+    });
+
+    connect(storage, &StorageService::ledgerSaved, this, [=](const QDate &d, bool ok){
+        if (!ok) {
+            QMessageBox::warning(this, "存檔失敗", "無法寫入 data/ 資料夾（權限或路徑問題）。");
+            return;
+        }
+        presence->markLedger(d);
+    });
+
+    connect(storage, &StorageService::todosSaved, this, [=](const QDate &d, bool ok){
+        if (!ok) {
+            QMessageBox::warning(this, "存檔失敗", "待辦無法寫入 data/...");
+            return;
+        }
+        presence->markTodo(d);
+    });
+
+    // ✅ 規則存好時 RecurrenceStore 已經是新的：重新展開當天的虛擬列與白點
+    connect(storage, &StorageService::recurringSaved, this, [=](bool ok){
+        if (!ok) QMessageBox::warning(this, "存檔失敗", "週期規則無法寫入 data/recurring.json");
+        clearMonthCache();
+        refreshCalendarMarks();
+        if (dayLoading) return;   // 讀完那天會自己展開
+
+        ledgerModel->setRecurring(RecurrenceStore::instance().ledgerOn(currentDate));
+        todoModel->setRecurring(RecurrenceStore::instance().todosOn(currentDate));
+        refreshDaySum();
+    });
+
+    // ✅ 復原 / 重做：搜尋框有焦點時由它自己處理
+    connect(new QShortcut(QKeySequence::Undo, this), &QShortcut::activated, this, [=]{ stepHistory(true); });
+    connect(new QShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_Z), this), &QShortcut::activated,
+            this, [=]{ stepHistory(false); });
+
+    // ✅ 初始化日期 + 載入今天記帳 + Todo
+    loadDay(QDate::currentDate());
+
+    monthTitle->setText(monthTitleZh(cal->yearShown(), cal->monthShown()));
+
+    connect(cal, &QCalendarWidget::clicked, this, [=](const QDate &d){
+        loadDay(d);
+        refreshMonthSummary(d);
+    });
+
+    connect(cal, &QCalendarWidget::currentPageChanged, this, [=](int y, int m){
+        monthTitle->setText(monthTitleZh(y, m));
+        refreshCalendarMarks();
+        if (cal->heatmapEnabled()) ensureDailyTotals(y);
+        refreshMonthSummary(QDate(y, m, 1));
+    });
+
+    refreshMonthSummary(currentDate);
+    if (warmStart) applySnapshot(snap);
+    refreshCalendarMarks();
+    storage->requestTodoIndex();   // 排在今天的讀取之後
+
+    // 預設進記帳頁
+    if (stack) stack->setCurrentIndex(0);
+}
+
+QWidget* MainWindow::buildTopTitle() {
+    auto *w = new QWidget(this);
+    auto *h = new QHBoxLayout(w);
+    h->setContentsMargins(0,0,0,0);
+
+    auto *title = new QLabel("行事曆", w);
+    title->setObjectName("topTitle");
+    title->setAlignment(Qt::AlignCenter);
+
+    auto mkToggle = [&](const QString& t){
+        auto *b = new QToolButton(w);
+        b->setText(t);
+        b->setCheckable(true);
+        b->setFixedSize(44, 28);
+        return b;
+    };
+    btnHeat = mkToggle("熱度");
+    btnYear = mkToggle("全年");
+
+    // 左邊放一樣寬的空白，標題才會置中
+    h->setSpacing(6);
+    h->addSpacing(44 * 2 + 6);
+    h->addStretch(1);
+    h->addWidget(title);
+    h->addStretch(1);
+    h->addWidget(btnHeat);
+    h->addWidget(btnYear);
+
+    connect(btnHeat, &QToolButton::toggled, this, [=](bool on){
+        cal->setHeatmapEnabled(on);
+        if (on) ensureDailyTotals(cal->yearShown());
+    });
+    connect(btnYear, &QToolButton::toggled, this, [=](bool on){ showYearOverview(on); });
+
+    return w;
+}
+
+QWidget* MainWindow::buildMonthBar() {
+    auto *w = new QWidget(this);
+    auto *h = new QHBoxLayout(w);
+    h->setContentsMargins(0,0,0,0);
+
+    auto mkBtn = [&](const QString& t){
+        auto *b = new QToolButton(w);
+        b->setText(t);
+        b->setFixedSize(34, 28);
+        return b;
+    };
+
+    auto *prev = mkBtn("‹");
+    auto *next = mkBtn("›");
+    monthTitle = new QLabel(w);
+    monthTitle->setAlignment(Qt::AlignCenter);
+    monthTitle->setObjectName("monthTitle");
+
+    h->addWidget(prev);
+    h->addStretch(1);
+    h->addWidget(monthTitle);
+    h->addStretch(1);
+    h->addWidget(next);
+
+    connect(prev, &QToolButton::clicked, this, [=]{ cal->showPreviousMonth(); });
+    connect(next, &QToolButton::clicked, this, [=]{ cal->showNextMonth(); });
+
+    return w;
+}
+
+QWidget* MainWindow::buildListPanel() {
+    auto *panel = new QFrame(this);
+    panel->setObjectName("listPanel");
+
+    auto *v = new QVBoxLayout(panel);
+    v->setContentsMargins(12,10,12,10);
+    v->setSpacing(8);
+
+    // ✅ 月總覽（固定最上方）
+    auto *summary = new QFrame(panel);
+    summary->setObjectName("monthSummary");
+    auto *sv = new QVBoxLayout(summary);
+    sv->setContentsMargins(10,10,10,10);
+    sv->setSpacing(6);
+
+    monthIncomeLabel  = new QLabel("本月收入: 0", summary);
+    monthExpenseLabel = new QLabel("本月支出: 0", summary);
+    budgetLabel       = new QLabel("預算: 未設定", summary);
+
+    budgetBar = new QProgressBar(summary);
+    budgetBar->setRange(0, 100);
+    budgetBar->setValue(0);
+    budgetBar->setTextVisible(false);
+
+    sv->addWidget(monthIncomeLabel);
+    sv->addWidget(monthExpenseLabel);
+    sv->addWidget(budgetLabel);
+    sv->addWidget(budgetBar);
+
+    v->addWidget(summary);
+
+    // ✅ 搜尋框：有字時切到結果頁，清空回原本的頁
+    searchBox = new QLineEdit(panel);
+    searchBox->setObjectName("searchBox");
+    searchBox->setPlaceholderText("搜尋備註、類別、待辦…");
+    searchBox->setClearButtonEnabled(true);
+    v->addWidget(searchBox);
+
+    searchTimer = new QTimer(this);
+    searchTimer->setSingleShot(true);
+    searchTimer->setInterval(150);
+    connect(searchTimer, &QTimer::timeout, this, [=]{ storage->requestSearch(searchBox->text()); });
+
+    // ✅ Stack：記帳頁 / 待辦頁
+    stack = new QStackedWidget(panel);
+    v->addWidget(stack);
+
+    // =========================
+    // Page 0：記帳
+    // =========================
+    auto *accPage = new QWidget(panel);
+    auto *av = new QVBoxLayout(accPage);
+    av->setContentsMargins(0,0,0,0);
+    av->setSpacing(8);
+
+    sumLabel = new QLabel("支出:0", accPage);
+    sumLabel->setObjectName("sumLabel");
+    av->addWidget(sumLabel);
+
+    // ✅ model/view：新增、刪除只動那一列，上千筆的日子也不用整批重建
+    auto *delegate = new DayItemDelegate(this);
+
+    ledgerModel = new LedgerModel(&account, this);
+    list = new QListView(accPage);
+    list->setObjectName("expenseList");
+    list->setModel(ledgerModel);
+    list->setItemDelegate(delegate);
+    list->setUniformItemSizes(true);
+    list->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    av->addWidget(list);
+
+    // ✅ 右鍵刪除單筆記帳
+    list->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(list, &QListView::customContextMenuRequested, this, [=](const QPoint &pos){
+        const QModelIndex at = list->indexAt(pos);
+        if (!at.isValid()) return;
+
+        int idx = at.row();
+
+        // 週期規則展開的那一列：略過這一次，或整個規則刪掉
+        const QString ruleId = ledgerModel->ruleIdAt(idx);
+        if (!ruleId.isEmpty()) {
+            QMenu menu;
+            QAction *skip = menu.addAction("略過這一次");
+            QAction *drop = menu.addAction("刪除整個週期");
+            QAction *chosen = menu.exec(list->viewport()->mapToGlobal(pos));
+            if (chosen == skip) {
+                ledgerModel->removeRecurringAt(idx);
+                storage->skipRecurring(ruleId, currentDate);
+                updateDayTotals(currentDate);
+                refreshDaySum();
+            } else if (chosen == drop) {
+                if (QMessageBox::question(this, "刪除", "確定刪除整個週期？已過去的也會一起消失。") != QMessageBox::Yes)
+                    return;
+                storage->removeRecurring(ruleId);
+                reloadAfterRuleChange();
+            }
+            return;
+        }
+
+        QMenu menu;
+        QAction *del = menu.addAction("刪除這筆記帳");
+        QAction *chosen = menu.exec(list->viewport()->mapToGlobal(pos));
+        if (chosen != del) return;
+
+        if (QMessageBox::question(this, "刪除", "確定刪除這筆記帳？") != QMessageBox::Yes)
+            return;
+
+        const AccountItem old = account.getItems().at(idx);
+        if (!ledgerModel->removeAt(idx)) return;
+        recordEdit(EditCommand::removeEntry(currentDate, idx, old));
+
+        saveLedger(currentDate);
+        refreshDaySum();
+    });
+
+    stack->addWidget(accPage);
+
+    // =========================
+    // Page 1：待辦
+    // =========================
+    auto *todoPage = new QWidget(panel);
+    auto *tv = new QVBoxLayout(todoPage);
+    tv->setContentsMargins(0,0,0,0);
+    tv->setSpacing(8);
+
+    todoModel = new TodoModel(&todos, &todoDone, this);
+    todoList = new QListView(todoPage);
+    todoList->setObjectName("todoList");
+    todoList->setModel(todoModel);
+    todoList->setItemDelegate(delegate);
+    todoList->setUniformItemSizes(true);
+    todoList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tv->addWidget(todoList);
+
+    // ✅ 勾選完成（點一下打勾/取消），並立刻存檔
+    connect(todoModel, &TodoModel::doneToggled, this, [=](int idx, bool done){
+        recordEdit(EditCommand::toggleTodo(currentDate, idx, done));
+        todoOps.append(Journal::opToggle(idx, done));
+        saveTodos(currentDate);
+    });
+    connect(todoModel, &TodoModel::recurringDoneToggled, this, [=](const QString &ruleId, bool done){
+        storage->setRecurringDone(ruleId, currentDate, done);
+    });
+
+    // ✅ 右鍵刪除 Todo
+    todoList->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(todoList, &QListView::customContextMenuRequested, this, [=](const QPoint &pos){
+        const QModelIndex at = todoList->indexAt(pos);
+        if (!at.isValid()) return;
+
+        int idx = at.row();
+
+        const QString ruleId = todoModel->ruleIdAt(idx);
+        if (!ruleId.isEmpty()) {
+            QMenu menu;
+            QAction *skip = menu.addAction("略過這一次");
+            QAction *drop = menu.addAction("刪除整個週期");
+            QAction *chosen = menu.exec(todoList->viewport()->mapToGlobal(pos));
+            if (chosen == skip) {
+                todoModel->removeRecurringAt(idx);
+                storage->skipRecurring(ruleId, currentDate);
+            } else if (chosen == drop) {
+                if (QMessageBox::question(this, "刪除", "確定刪除整個週期？") != QMessageBox::Yes)
+                    return;
+                storage->removeRecurring(ruleId);
+            }
+            return;
+        }
+
+        QMenu menu;
+        QAction *del = menu.addAction("刪除這個待辦");
+        QAction *chosen = menu.exec(todoList->viewport()->mapToGlobal(pos));
+        if (chosen != del) return;
+
+        if (QMessageBox::question(this, "刪除", "確定刪除這個待辦？") != QMessageBox::Yes)
+            return;
+
+        const Todo old = todos.at(idx);
+        const bool wasDone = idx < todoDone.size() && todoDone.at(idx);
+        if (!todoModel->removeAt(idx)) return;
+        todoOps.append(Journal::opRemove(idx));
+        recordEdit(EditCommand::removeTodo(currentDate, idx, old, wasDone));
+
+        saveTodos(currentDate);
+    });
+
+    stack->addWidget(todoPage);
+
+    // =========================
+    // Page 2：搜尋結果
+    // =========================
+    searchList = new QListWidget(panel);
+    searchList->setObjectName("searchList");
+    searchList->setItemDelegate(delegate);
+    searchList->setUniformItemSizes(true);
+    stack->addWidget(searchList);
+
+    connect(searchBox, &QLineEdit::textChanged, this, [=](const QString &text){
+        if (text.trimmed().isEmpty()) {
+            searchTimer->stop();
+            if (stack->currentIndex() == 2) stack->setCurrentIndex(pageBeforeSearch);
+            return;
+        }
+        if (stack->currentIndex() != 2) pageBeforeSearch = stack->currentIndex();
+        stack->setCurrentIndex(2);
+        searchTimer->start();
+    });
+
+    // ✅ 點結果：跳到那天，切到對應的頁
+    connect(searchList, &QListWidget::itemClicked, this, [=](QListWidgetItem *it){
+        const QDate d = it->data(Qt::UserRole).toDate();
+        if (!d.isValid()) return;
+        const bool todo = it->data(kHitTodoRole).toBool();
+
+        searchBox->clear();
+        cal->setCurrentPage(d.year(), d.month());
+        cal->setChosenDate(d);
+        loadDay(d);
+        refreshMonthSummary(d);
+        stack->setCurrentIndex(todo ? 1 : 0);
+    });
+
+    return panel;
+}
+
+QWidget* MainWindow::buildBottomBar() {
+    auto *w = new QWidget(this);
+    auto *h = new QHBoxLayout(w);
+    h->setContentsMargins(0,8,0,0);
+    h->setSpacing(10);
+
+    auto mk = [&](const QString& t){
+        auto *b = new QToolButton(w);
+        b->setText(t);
+        b->setToolButtonStyle(Qt::ToolButtonTextOnly);
+        b->setFixedHeight(44);
+        return b;
+    };
+
+    btnBook = mk("帳本");
+    btnPlus = mk("+");
+    btnTodo = mk("待辦事項");
+    btnPlus->setObjectName("plusBtn");
+
+    h->addWidget(btnBook, 1);
+    h->addWidget(btnPlus, 1);
+    h->addWidget(btnTodo, 1);
+
+    // ✅ 設定預算（寫進當天 json）
+    connect(btnBook, &QToolButton::clicked, this, [=]{
+        if (dayLoading) return;   // 還沒讀完那天，預算會存錯天
+
+        // 1) 先切回「記帳頁」
+        if (stack) stack->setCurrentIndex(0);
+
+        // 2) 選單：設定 / 重設
+        QMenu menu;
+        QAction *actSet   = menu.addAction("設定本月預算");
+        QAction *actReset = menu.addAction("重設本月預算（清空）");
+        menu.addSeparator();
+        QAction *actBalance = menu.addAction("累計餘額走勢");
+
+        QAction *act = menu.exec(btnBook->mapToGlobal(QPoint(btnBook->width()/2, btnBook->height())));
+        if (!act) return;
+
+        if (act == actBalance) {
+            storage->requestBalanceIndex();   // 建好（或本來就好）後 showBalanceChart
+            return;
+        }
+
+        if (act == actSet) {
+            bool ok = false;
+            double b = QInputDialog::getDouble(
+                this,
+                "設定預算",
+                "本月預算：",
+                account.getMonthlyBudget(),
+                0, 1e9, 0,
+                &ok
+                );
+            if (!ok) return;
+
+            recordEdit(EditCommand::setBudget(currentDate, account.getMonthlyBudget(), b));
+            account.setMonthlyBudget(b);
+            saveLedger(currentDate);
+            budget->setBudget(b, true);
+            return;
+        }
+
+        if (act == actReset) {
+            if (QMessageBox::question(this, "重設預算", "確定要清空本月預算？") != QMessageBox::Yes)
+                return;
+
+            recordEdit(EditCommand::setBudget(currentDate, account.getMonthlyBudget(), 0));
+            account.setMonthlyBudget(0);
+            saveLedger(currentDate);
+            budget->setBudget(0);
+            return;
+        }
+    });
+
+    // ✅ 新增（記帳/待辦）
+    connect(btnPlus, &QToolButton::clicked, this, [=]{
+        // 記帳 / 待辦必須是選到那天已讀完的內容，否則會把別天的資料存過去
+        QDate d = cal->chosenDate();
+        if (dayLoading || d != currentDate) {
+            loadDay(d);
+            return;
+        }
+
+        AddEntryDialog dlg(d, this);
+        dlg.setDayTodos(todos);
+
+        connect(&dlg, &AddEntryDialog::savedExpenseIncome, this, [=](const AccountItem& item){
+            recordEdit(EditCommand::addEntry(d, ledgerModel->realRows(), item));
+            ledgerModel->addItem(item);
+            saveLedger(d);
+            refreshDaySum();
+
+            if (stack) stack->setCurrentIndex(0); // 回到記帳頁
+        });
+
+        connect(&dlg, &AddEntryDialog::savedTodo, this, [=](const Todo& td){
+            recordEdit(EditCommand::addTodo(d, todos.size(), td));
+            todoModel->append(td, false);
+            todoOps.append(Journal::opAdd(TodoStore::toJson(td, false)));
+
+            saveTodos(d);
+
+            if (stack) stack->setCurrentIndex(1); // 切去待辦頁看到新增結果
+        });
+
+        // 週期規則：不寫日檔，存好後（recurringSaved）才展開到清單
+        connect(&dlg, &AddEntryDialog::savedRecurring, this, [=](const RecurrenceRule& r){
+            storage->addRecurring(r);
+            if (!r.isTodo) reloadAfterRuleChange();
+
+            if (stack) stack->setCurrentIndex(r.isTodo ? 1 : 0);
+        });
+
+        dlg.exec();
+    });
+
+    // ✅ 待辦事項：切換到待辦頁
+    connect(btnTodo, &QToolButton::clicked, this, [=]{
+        if (!stack) return;
+        stack->setCurrentIndex(1);
+    });
+
+    return w;
+}
+
+// ✅ 當天支出合計（清單本身由 model 逐列更新）
+void MainWindow::refreshDaySum() {
+    TRACE_SCOPE("MainWindow::refreshDaySum");
+    if (!sumLabel) return;
+    sumLabel->setText(QString("支出:%1").arg(ledgerModel->dailyExpense()));
+}
+
+// ✅ 行事曆白點：記帳檔 or Todo 檔，有任一個就標記（直接查 bitmap，不 stat）
+// 週期規則落在這個月的日子也算
+void MainWindow::refreshCalendarMarks() {
+    TRACE_SCOPE("MainWindow::refreshCalendarMarks");
+    const QDate first(cal->yearShown(), cal->monthShown(), 1);
+    // 資料夾還沒列：只有快照那個月畫得出來
+    QSet<QDate> marks = presence->isScanned() ? presence->marksForMonth(first.year(), first.month())
+                                              : snapshotMarks;
+    auto cached = monthCache.constFind(monthKey(first.year(), first.month()));
+    marks.unite(cached != monthCache.constEnd() ? cached->recurringDates
+                                                : RecurrenceStore::instance().datesIn(first, first.addMonths(1).addDays(-1)));
+    cal->setMarkedDates(marks);
+}
+
+// 每日索引直接用記憶體裡的數字更新（含週期規則展開的），不等存檔
+void MainWindow::updateDayTotals(const QDate& d) {
+    cal->setDayTotals(d, ledgerModel->dailyIncome(), ledgerModel->dailyExpense());
+    yearView->setDayTotals(d, ledgerModel->dailyIncome(), ledgerModel->dailyExpense());
+}
+
+// ✅ 記帳規則新增 / 刪除會動到很多天：月統計與每日索引整份重查
+// 都排在規則變動之後，工作執行緒依序跑，查到的一定是新的
+void MainWindow::reloadAfterRuleChange() {
+    clearMonthCache();
+    refreshMonthSummary(QDate(cal->yearShown(), cal->monthShown(), 1));
+    if (cal->hasDailyTotals(cal->yearShown())) storage->requestYear(cal->yearShown());
+}
+
+void MainWindow::ensureDailyTotals(int year) {
+    if (!cal->hasDailyTotals(year)) storage->requestYear(year);
+}
+
+// ✅ 年度總覽：從最早有記帳的那年到今年
+void MainWindow::showYearOverview(bool on) {
+    if (on) {
+        const int thisYear = QDate::currentDate().year();
+        const int first = presence->firstLedgerYear();
+        yearView->setYearRange(first > 0 ? qMin(first, thisYear) : thisYear, thisYear);
+        yearView->scrollToYear(cal->yearShown());
+    }
+    calStack->setCurrentIndex(on ? 1 : 0);
+}
+
+// ✅ 累計餘額：區間可選，查詢都走 BalanceIndex
+void MainWindow::showBalanceChart() {
+    QDialog dlg(this);
+    dlg.setWindowTitle("累計餘額");
+    dlg.resize(420, 320);
+
+    auto *v = new QVBoxLayout(&dlg);
+    auto *range = new QComboBox(&dlg);
+    range->addItems({"近 3 個月", "近 1 年", "全部"});
+    range->setCurrentIndex(1);
+    auto *info = new QLabel(&dlg);
+    auto *chart = new BalanceChart(&dlg);
+
+    v->addWidget(range);
+    v->addWidget(info);
+    v->addWidget(chart, 1);
+
+    auto apply = [=](int i){
+        const QDate to = QDate::currentDate();
+        const QDate from = (i == 0) ? to.addMonths(-3)
+                         : (i == 1) ? to.addYears(-1)
+                                    : BalanceIndex::instance().firstDate();
+        chart->setRange(from, to);
+        info->setText(QString("目前餘額 %1　區間淨額 %2")
+                          .arg(BalanceIndex::instance().balanceAt(to))
+                          .arg(BalanceIndex::instance().rangeNet(from, to)));
+    };
+    connect(range, QOverload<int>::of(&QComboBox::currentIndexChanged), &dlg, apply);
+    apply(range->currentIndex());
+
+    dlg.exec();
+}
+
+// ✅ 月統計交給背景執行緒，回來後成為 BudgetTracker 的基準
+void MainWindow::refreshMonthSummary(const QDate& d)
+{
+    TRACE_SCOPE("MainWindow::refreshMonthSummary");
+    monthTotalsReady = false;
+    budget->beginMonth(d.year(), d.month());
+
+    // ✅ 預讀過的月份直接當基準，不必等工作執行緒
+    auto it = monthCache.constFind(monthKey(d.year(), d.month()));
+    if (it != monthCache.constEnd()) {
+        monthTotalsReady = true;
+        budget->setBaseline(d.year(), d.month(), it->totals.income, it->totals.expense);
+    } else {
+        storage->requestMonth(d.year(), d.month());
+    }
+
+    storage->prefetchMonths(d.year(), d.month(), monthCacheEpoch);
+}
+
+void MainWindow::cacheMonth(int year, int month, const MonthPrefetch& data)
+{
+    const int key = monthKey(year, month);
+    monthCacheOrder.removeOne(key);
+    monthCacheOrder.append(key);
+    monthCache.insert(key, data);
+
+    while (monthCacheOrder.size() > kMonthCacheSize)
+        monthCache.remove(monthCacheOrder.takeFirst());
+}
+
+void MainWindow::invalidateMonth(const QDate& d)
+{
+    const int key = monthKey(d.year(), d.month());
+    monthCacheEpoch++;
+    monthCache.remove(key);
+    monthCacheOrder.removeOne(key);
+}
+
+void MainWindow::clearMonthCache()
+{
+    monthCacheEpoch++;
+    monthCache.clear();
+    monthCacheOrder.clear();
+}
+
+void MainWindow::updateBudgetView()
+{
+    if (!monthIncomeLabel || !monthExpenseLabel || !budgetLabel || !budgetBar) return;
+
+    double mIncome  = budget->income();
+    double mExpense = budget->expense();
+
+    monthIncomeLabel->setText(QString("本月收入: %1").arg(mIncome));
+    monthExpenseLabel->setText(QString("本月支出: %1").arg(mExpense));
+
+    double b = budget->budget();
+    if (b <= 0) {
+        budgetLabel->setText("預算: 未設定");
+        budgetBar->setEnabled(false);
+        budgetBar->setValue(0);
+        return;
+    }
+
+    budgetBar->setEnabled(true);
+    budgetLabel->setText(QString("預算: %1（已用 %2）").arg(b).arg(mExpense));
+
+    int pct = int(budget->usedPercent());
+    if (pct < 0) pct = 0;
+    if (pct > 100) pct = 100;
+    budgetBar->setValue(pct);
+}
+
+// ====== ✅ 載入 / 存檔（背景執行緒） ======
+void MainWindow::loadDay(const QDate& d) {
+    if (pendingStep && d != pendingStepDate) pendingStep = 0;   // 跳過去的途中點了別天
+    currentDate = d;
+    setDayLoading(true);
+    storage->requestDay(d, account.getMonthlyBudget());
+}
+
+void MainWindow::setDayLoading(bool loading) {
+    dayLoading = loading;
+    if (list) list->setEnabled(!loading);
+    if (todoList) todoList->setEnabled(!loading);
+    if (btnPlus) btnPlus->setEnabled(!loading);
+}
+
+void MainWindow::saveLedger(const QDate& d) {
+    invalidateMonth(d);
+    storage->saveLedger(d, account);
+    account.clearPendingOps();
+    updateDayTotals(d);
+}
+
+void MainWindow::saveTodos(const QDate& d) {
+    storage->saveTodos(d, todos, todoDone, todoOps);
+    todoOps.clear();
+}
+
+// ====== ✅ 暖啟動 ======
+void MainWindow::trackFirstPaint(const QElapsedTimer& since) {
+    startClock = since;
+}
+
+bool MainWindow::eventFilter(QObject *obj, QEvent *e) {
+    if (firstPaintPending && e->type() == QEvent::Paint && obj == centralWidget()) {
+        firstPaintPending = false;
+        qInfo().noquote() << QString("startup: first paint after %1 ms (%2)")
+                                 .arg(startClock.elapsed())
+                                 .arg(warmStart ? "warm, from snapshot" : "cold");
+        // 這一輪畫完再做
+        QTimer::singleShot(0, this, [=]{ startBackgroundRefresh(); });
+    }
+    return QMainWindow::eventFilter(obj, e);
+}
+
+// 快照的內容先放進清單與月總覽；讀取中的那天回來（dayLoaded）會整個換掉
+void MainWindow::applySnapshot(const StartupSnapshot& s) {
+    Account a;
+    for (const AccountItem &item : s.items) a.addItem(item);
+    if (s.hasBudget) a.setMonthlyBudget(s.monthlyBudget);
+    a.clearPendingOps();
+
+    ledgerModel->setAccount(a, RecurrenceStore::instance().ledgerOn(s.date));
+    todoModel->setTodos(s.todos, s.todoDone, RecurrenceStore::instance().todosOn(s.date));
+    refreshDaySum();
+
+    snapshotMarks.clear();
+    for (const QDate &d : s.marks) snapshotMarks.insert(d);
+    if (s.hasBudget) budget->setBudget(s.monthlyBudget);
+    if (s.hasTotals) budget->setProvisional(s.date.year(), s.date.month(), s.monthIncome, s.monthExpense);
+}
+
+// ✅ 第一個畫面之後：列一次資料夾，白點換成真正的（changed -> refreshCalendarMarks）
+void MainWindow::startBackgroundRefresh() {
+    snapshotMarks.clear();
+    presence->rescan();
+    refreshCalendarMarks();
+}
+
+StartupSnapshot MainWindow::startupSnapshot() const {
+    StartupSnapshot s;
+    const QDate today = QDate::currentDate();
+    if (dayLoading || currentDate != today || !presence->isScanned()) return s;
+
+    s.date = today;
+    s.items = account.getItems();
+    s.hasBudget = true;
+    s.monthlyBudget = account.getMonthlyBudget();
+    s.todos = todos;
+    s.todoDone = todoDone;
+
+    for (const QDate &d : presence->marksForMonth(today.year(), today.month()))
+        s.marks.append(d);
+
+    if (monthTotalsReady && budget->month() == QDate(today.year(), today.month(), 1)) {
+        s.hasTotals = true;
+        s.monthIncome = budget->income();
+        s.monthExpense = budget->expense();
+    }
+    return s;
+}
+
+// ====== ✅ 復原 / 重做 ======
+void MainWindow::recordEdit(const EditCommand& c) {
+    if (!replaying) history.push(c);
+}
+
+static bool sameEntry(const AccountItem &a, const AccountItem &b) {
+    return a.amount == b.amount && a.categoryId == b.categoryId && a.type == b.type && a.note == b.note;
+}
+
+// 只能套在紀錄的那天：別天的先跳過去，讀完（dayLoaded）再回來
+void MainWindow::stepHistory(bool undo) {
+    if (undo ? !history.canUndo() : !history.canRedo()) return;
+    const EditCommand c = undo ? history.nextUndo() : history.nextRedo();
+
+    if (dayLoading || c.date != currentDate) {
+        pendingStep = undo ? 1 : 2;
+        pendingStepDate = c.date;
+        if (c.date != currentDate) {
+            cal->setCurrentPage(c.date.year(), c.date.month());
+            cal->setChosenDate(c.date);
+            loadDay(c.date);
+            refreshMonthSummary(c.date);
+        }
+        return;
+    }
+
+    if (!applyEdit(c, !undo)) {
+        // 那天的內容跟紀錄對不上（例如檔案被外部改過）：後面的步驟也不可靠了
+        history.clear();
+        QMessageBox::information(this, undo ? "復原" : "重做",
+                                 QString("無法%1：%2").arg(undo ? "復原" : "重做").arg(c.describe()));
+        return;
+    }
+    if (undo) history.undone();
+    else history.redone();
+
+    const bool isTodo = (c.kind == EditCommand::AddTodo || c.kind == EditCommand::RemoveTodo
+                         || c.kind == EditCommand::ToggleTodo);
+    if (stack && stack->currentIndex() != 2) stack->setCurrentIndex(isTodo ? 1 : 0);
+}
+
+// forward：重做（照原本的方向），否則反過來；都只存那一天
+bool MainWindow::applyEdit(const EditCommand& c, bool forward) {
+    const auto &items = account.getItems();
+    bool ok = false;
+    replaying = true;
+
+    switch (c.kind) {
+    case EditCommand::AddEntry:
+    case EditCommand::RemoveEntry:
+        if (forward == (c.kind == EditCommand::AddEntry)) {
+            ok = ledgerModel->insertAt(c.index, c.entry);
+        } else {
+            ok = c.index >= 0 && c.index < items.size() && sameEntry(items.at(c.index), c.entry)
+                 && ledgerModel->removeAt(c.index);
+        }
+        break;
+    case EditCommand::UpdateEntry:
+        ok = c.index >= 0 && c.index < items.size()
+             && sameEntry(items.at(c.index), forward ? c.previous : c.entry)
+             && ledgerModel->updateAt(c.index, forward ? c.entry : c.previous);
+        break;
+    case EditCommand::SetBudget: {
+        const double b = forward ? c.budgetAfter : c.budgetBefore;
+        account.setMonthlyBudget(b);
+        budget->setBudget(b);
+        ok = true;
+        break;
+    }
+    case EditCommand::AddTodo:
+    case EditCommand::RemoveTodo:
+        if (forward == (c.kind == EditCommand::AddTodo)) {
+            ok = todoModel->insertAt(c.index, c.todo, c.done);
+            if (ok) todoOps.append(Journal::opInsert(c.index, TodoStore::toJson(c.todo, c.done)));
+        } else {
+            ok = c.index >= 0 && c.index < todos.size() && todos.at(c.index).title == c.todo.title
+                 && todoModel->removeAt(c.index);
+            if (ok) todoOps.append(Journal::opRemove(c.index));
+        }
+        break;
+    case EditCommand::ToggleTodo: {
+        // 走 setData：doneToggled 會記下異動並存檔
+        const bool d = forward ? c.done : !c.done;
+        ok = c.index >= 0 && c.index < todoDone.size();
+        if (ok && todoDone.at(c.index) != d)
+            todoModel->setData(todoModel->index(c.index), d ? Qt::Checked : Qt::Unchecked, Qt::CheckStateRole);
+        break;
+    }
+    }
+    replaying = false;
+    if (!ok) return false;
+
+    if (c.kind == EditCommand::AddTodo || c.kind == EditCommand::RemoveTodo) {
+        saveTodos(c.date);
+    } else if (c.kind != EditCommand::ToggleTodo) {
+        saveLedger(c.date);
+        refreshDaySum();
+    }
+    return true;
+}
+
+void MainWindow::applyStyle() {
+    qApp->setStyleSheet(QString(R"(
+        QWidget { background: %1; color: %2; }
+
+        QLabel#topTitle { font-size: 18px; font-weight: 700; color: %2; padding: 6px 0px; }
+        QLabel#monthTitle { font-size: 20px; font-weight: 700; color: %2; }
+
+        QToolButton { border: 1px solid #2A2A2A; border-radius: 12px; background: #121212; color: %2; padding: 6px; }
+        QToolButton:hover { background: #1A1A1A; }
+        QToolButton:checked { background: #2A2A2A; border-color: #F5A623; }
+
+        QToolButton#plusBtn { font-size: 18px; font-weight: 700; background: #EDEDED; color: #111; border: none; }
+
+        QFrame#listPanel { background: %3; border: 1px solid #1E1E1E; border-radius: 14px; }
+        QFrame#monthSummary { background: %3; border: 1px solid #1E1E1E; border-radius: 14px; }
+
+        QProgressBar { border: 1px solid #2A2A2A; border-radius: 8px; padding: 2px; background: #121212; min-height: 12px; }
+        QProgressBar::chunk { background: #EDEDED; border-radius: 8px; }
+
+        QLabel#sumLabel { color: %2; font-size: 14px; padding: 6px 2px; }
+        QLineEdit#searchBox { background: #121212; border: 1px solid #2A2A2A; border-radius: 10px; padding: 6px 10px; color: %2; }
+
+        QListView { background: transparent; border: none; }
+    )").arg(BG.name(), TEXT.name(), PANEL.name()));
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <QMainWindow>
+#include <QDate>
+#include <QVector>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QHash>
+
+#include "models.h"
+#include "account.h"
+#include "ledgerquery.h"
+#include "edithistory.h"
+#include "startupsnapshot.h"
+#include "storageservice.h"
+
+class QLabel;
+class QListView;
+class QListWidget;
+class QLineEdit;
+class QTimer;
+class QToolButton;
+class DotCalendar;
+class YearView;
+class QProgressBar;
+class QStackedWidget;
+class DatePresence;
+class LedgerModel;
+class TodoModel;
+class BudgetTracker;
+
+class MainWindow : public QMainWindow {
+    Q_OBJECT
+public:
+    explicit MainWindow(QWidget *parent=nullptr);
+
+    // ✅ 啟動量測：從 since 起算到第一個畫面畫出來（沒給就從建構算起）
+    void trackFirstPaint(const QElapsedTimer& since);
+    // 離開前取：今天讀完的內容與本月白點 / 收支；不完整時回傳無效的快照
+    StartupSnapshot startupSnapshot() const;
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *e) override;
+
+private:
+    void applyStyle();
+    QWidget* buildTopTitle();
+    QWidget* buildMonthBar();
+    QWidget* buildListPanel();
+    QWidget* buildBottomBar();
+
+    void refreshDaySum();
+    void refreshCalendarMarks();
+    void updateDayTotals(const QDate& d);
+    void reloadAfterRuleChange();
+    void ensureDailyTotals(int year);
+    void showYearOverview(bool on);
+    void showBalanceChart();
+
+    void refreshMonthSummary(const QDate& d);
+    // 預讀的月份快取；那個月有存檔、規則有變就作廢
+    void cacheMonth(int year, int month, const MonthPrefetch& data);
+    void invalidateMonth(const QDate& d);
+    void clearMonthCache();
+    void updateBudgetView();
+
+    // ===== 載入 / 存檔（StorageService） =====
+    void loadDay(const QDate& d);
+    void setDayLoading(bool loading);
+    void saveLedger(const QDate& d);
+    void saveTodos(const QDate& d);
+
+    // ===== 暖啟動 =====
+    void applySnapshot(const StartupSnapshot& s);
+    void startBackgroundRefresh();
+
+    // ===== 復原 / 重做 =====
+    void recordEdit(const EditCommand& c);
+    void stepHistory(bool undo);
+    bool applyEdit(const EditCommand& c, bool forward);
+
+private:
+    DotCalendar *cal = nullptr;
+    YearView *yearView = nullptr;
+    QStackedWidget *calStack = nullptr;     // 月曆 / 年度總覽
+    QToolButton *btnHeat = nullptr;
+    QToolButton *btnYear = nullptr;
+    DatePresence *presence = nullptr;
+    StorageService *storage = nullptr;
+    QLabel *monthTitle = nullptr;
+
+    // ✅ 月總覽
+    QLabel *monthIncomeLabel = nullptr;
+    QLabel *monthExpenseLabel = nullptr;
+    QLabel *budgetLabel = nullptr;
+    QProgressBar *budgetBar = nullptr;
+    BudgetTracker *budget = nullptr;   // 本月累計與預算門檻
+
+    // ✅ 中間區：切換 記帳/待辦/搜尋結果
+    QStackedWidget *stack = nullptr;
+
+    // ✅ 全文搜尋
+    QLineEdit *searchBox = nullptr;
+    QListWidget *searchList = nullptr;   // Page 2：最多 100 筆結果
+    QTimer *searchTimer = nullptr;       // 打字停下來才查
+    int pageBeforeSearch = 0;
+
+    // Page 0：記帳
+    QLabel *sumLabel = nullptr;
+    QListView *list = nullptr;
+    LedgerModel *ledgerModel = nullptr;
+
+    // Page 1：待辦
+    QListView *todoList = nullptr;
+    TodoModel *todoModel = nullptr;
+
+    QToolButton *btnBook = nullptr;
+    QToolButton *btnPlus = nullptr;
+    QToolButton *btnTodo = nullptr;
+
+    // ✅ 記帳
+    Account account;
+    QDate currentDate;
+    bool dayLoading = false;
+
+    // ✅ Todo
+    QVector<Todo> todos;
+    QVector<bool> todoDone;
+    QVector<QJsonObject> todoOps;   // 上次存檔後的待辦異動（journal 模式用）
+
+    // ✅ 復原 / 重做（Ctrl+Z / Ctrl+Shift+Z）
+    EditHistory history;
+    bool replaying = false;   // 套用歷史時不再記一次
+    int pendingStep = 0;      // 1 復原、2 重做：別天的編輯，等那天讀完再套用
+    QDate pendingStepDate;    // pendingStep 要等的那天；中途改看別天就取消
+
+    // ✅ 暖啟動
+    QElapsedTimer startClock;
+    bool firstPaintPending = true;
+    bool warmStart = false;
+    QSet<QDate> snapshotMarks;       // 資料夾還沒列之前先畫這些白點
+    bool monthTotalsReady = false;   // 本月統計回來過（快照才記收支）
+
+    // ✅ 前後月份預讀（key 見 monthKey），最多留 kMonthCacheSize 個
+    static const int kMonthCacheSize = 6;
+    QHash<int, MonthPrefetch> monthCache;
+    QVector<int> monthCacheOrder;     // 舊的在前
+    int monthCacheEpoch = 0;          // 每次作廢 +1；預讀帶著發出時的值，回來時不同就不收
+};
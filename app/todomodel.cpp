@@ -0,0 +1,134 @@
+#include "todomodel.h"
+
+TodoModel::TodoModel(QVector<Todo> *todos, QVector<bool> *done, QObject *parent)
+    : QAbstractListModel(parent),
+    todos(todos),
+    done(done)
+{
+}
+
+int TodoModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : todos->size() + recurring.size();
+}
+
+QVariant TodoModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount()) return QVariant();
+
+    const int n = todos->size();
+    const bool virt = index.row() >= n;
+    const Todo &td = virt ? recurring.at(index.row() - n).todo : todos->at(index.row());
+    const QString timeInfo = td.allDay
+                                 ? "全天"
+                                 : QString("%1-%2")
+                                       .arg(td.start.time().toString("hh:mm"))
+                                       .arg(td.end.time().toString("hh:mm"));
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return QString("%1\n%2").arg(td.title).arg(timeInfo);
+    case TitleRole:
+        return virt ? QString("↻ %1").arg(td.title) : td.title;
+    case DetailRole:
+        return timeInfo;
+    case Qt::CheckStateRole: {
+        const bool d = virt ? recurring.at(index.row() - n).done
+                            : index.row() < done->size() && done->at(index.row());
+        return d ? Qt::Checked : Qt::Unchecked;
+    }
+    case RecurringRole:
+        return virt ? recurring.at(index.row() - n).ruleId : QString();
+    default:
+        return QVariant();
+    }
+}
+
+bool TodoModel::setData(const QModelIndex &index, const QVariant &value, int role) {
+    if (role != Qt::CheckStateRole || !index.isValid()) return false;
+
+    const int row = index.row();
+    const bool d = (value.toInt() == Qt::Checked);
+
+    const int i = row - todos->size();
+    if (i >= 0 && i < recurring.size()) {
+        if (recurring[i].done == d) return false;
+        recurring[i].done = d;
+        emit dataChanged(index, index, {Qt::CheckStateRole});
+        emit recurringDoneToggled(recurring[i].ruleId, d);
+        return true;
+    }
+    if (row >= done->size()) return false;
+
+    if ((*done)[row] == d) return false;
+
+    (*done)[row] = d;
+    emit dataChanged(index, index, {Qt::CheckStateRole});
+    emit doneToggled(row, d);
+    return true;
+}
+
+Qt::ItemFlags TodoModel::flags(const QModelIndex &index) const {
+    if (!index.isValid()) return Qt::NoItemFlags;
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsUserCheckable;
+}
+
+void TodoModel::setTodos(const QVector<Todo> &t, const QVector<bool> &d, const QVector<RecurringTodo> &r) {
+    beginResetModel();
+    *todos = t;
+    *done = d;
+    recurring = r;
+    endResetModel();
+}
+
+void TodoModel::setRecurring(const QVector<RecurringTodo> &r) {
+    const int n = todos->size();
+    if (!recurring.isEmpty()) {
+        beginRemoveRows(QModelIndex(), n, n + recurring.size() - 1);
+        recurring.clear();
+        endRemoveRows();
+    }
+    if (!r.isEmpty()) {
+        beginInsertRows(QModelIndex(), n, n + r.size() - 1);
+        recurring = r;
+        endInsertRows();
+    }
+}
+
+QString TodoModel::ruleIdAt(int row) const {
+    const int i = row - todos->size();
+    return (i >= 0 && i < recurring.size()) ? recurring.at(i).ruleId : QString();
+}
+
+bool TodoModel::removeRecurringAt(int row) {
+    const int i = row - todos->size();
+    if (i < 0 || i >= recurring.size()) return false;
+    beginRemoveRows(QModelIndex(), row, row);
+    recurring.removeAt(i);
+    endRemoveRows();
+    return true;
+}
+
+void TodoModel::append(const Todo &td, bool d) {
+    const int row = todos->size();   // 插在虛擬列前面
+    beginInsertRows(QModelIndex(), row, row);
+    todos->append(td);
+    done->append(d);
+    endInsertRows();
+}
+
+bool TodoModel::insertAt(int row, const Todo &td, bool d) {
+    if (row < 0 || row > todos->size() || row > done->size()) return false;
+    beginInsertRows(QModelIndex(), row, row);
+    todos->insert(row, td);
+    done->insert(row, d);
+    endInsertRows();
+    return true;
+}
+
+bool TodoModel::removeAt(int row) {
+    if (row < 0 || row >= todos->size()) return false;
+    beginRemoveRows(QModelIndex(), row, row);
+    todos->removeAt(row);
+    if (row < done->size()) done->removeAt(row);
+    endRemoveRows();
+    return true;
+}
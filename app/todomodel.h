@@ -0,0 +1,42 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QVector>
+
+#include "models.h"
+#include "recurrence.h"
+
+// ✅ 當天待辦清單：讀 MainWindow 的 todos / todoDone
+// 勾選走 setData(CheckStateRole)，再以 doneToggled 通知 MainWindow 存檔
+// 週期待辦接在後面（虛擬列），勾選改發 recurringDoneToggled，完成狀態記在規則上
+class TodoModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    enum Roles { TitleRole = Qt::UserRole + 1, DetailRole, RecurringRole };
+
+    TodoModel(QVector<Todo> *todos, QVector<bool> *done, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    // 換了一天才整批重設
+    void setTodos(const QVector<Todo> &t, const QVector<bool> &d, const QVector<RecurringTodo> &r = {});
+    void setRecurring(const QVector<RecurringTodo> &r);
+
+    QString ruleIdAt(int row) const;   // 不是虛擬列就回傳空字串
+    bool removeRecurringAt(int row);
+
+    void append(const Todo &td, bool done);
+    bool insertAt(int row, const Todo &td, bool done);   // 復原刪除：放回原位
+    bool removeAt(int row);
+
+signals:
+    void doneToggled(int row, bool done);
+    void recurringDoneToggled(const QString &ruleId, bool done);
+
+private:
+    QVector<Todo> *todos;
+    QVector<bool> *done;
+    QVector<RecurringTodo> recurring;
+};
@@ -0,0 +1,205 @@
+#include "yearview.h"
+#include "dotcalendar.h"
+
+#include <QPainter>
+#include <QMouseEvent>
+#include <QScrollBar>
+
+static const QColor BG("#0B0B0B");
+static const QColor TEXT("#EDEDED");
+static const QColor DIM("#9A9A9A");
+static const QColor EMPTY("#1A1A1A");
+static const QColor ACCENT("#F5A623");
+
+static const int HEADER = 30;   // 年份標題列
+static const int MONTH_TITLE = 16;
+
+YearView::YearView(QWidget *parent)
+    : QAbstractScrollArea(parent),
+    firstYear(QDate::currentDate().year()),
+    lastYear(QDate::currentDate().year()),
+    today(QDate::currentDate())
+{
+    setFrameShape(QFrame::NoFrame);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    viewport()->setAutoFillBackground(false);
+    relayout();
+}
+
+void YearView::setYearRange(int first, int last) {
+    if (first > last) std::swap(first, last);
+    if (first == firstYear && last == lastYear) return;
+    firstYear = first;
+    lastYear = last;
+    relayout();
+    viewport()->update();
+}
+
+void YearView::scrollToYear(int year) {
+    verticalScrollBar()->setValue(yearTop(qBound(firstYear, year, lastYear)));
+}
+
+void YearView::setDailyTotals(const DailyTotals &t) {
+    totals.insert(t.year(), t);
+    invalidateYear(t.year());
+}
+
+void YearView::setDayTotals(const QDate &d, double income, double expense) {
+    auto it = totals.find(d.year());
+    if (it == totals.end()) return;
+    it->setDay(d, income, expense);
+    invalidateYear(d.year());
+}
+
+void YearView::invalidateYear(int year) {
+    cache.remove(year);
+    const int y = yearTop(year) - verticalScrollBar()->value();
+    if (y < viewport()->height() && y + lay.yearH > 0)
+        viewport()->update(QRect(0, y, viewport()->width(), lay.yearH));
+}
+
+// ✅ 3 欄 x 4 列的小月曆；格子大小跟著寬度走
+void YearView::relayout() {
+    const int w = qMax(200, viewport()->width());
+    lay.gap = 12;
+    lay.cell = qMax(6, (w - lay.gap * 4) / 21);
+    lay.monthW = lay.cell * 7;
+    lay.monthH = MONTH_TITLE + lay.cell * 6;
+    lay.yearH = HEADER + 4 * (lay.monthH + lay.gap);
+    lay.left = (w - (lay.monthW * 3 + lay.gap * 2)) / 2;
+
+    const int total = (lastYear - firstYear + 1) * lay.yearH;
+    verticalScrollBar()->setRange(0, qMax(0, total - viewport()->height()));
+    verticalScrollBar()->setPageStep(viewport()->height());
+    verticalScrollBar()->setSingleStep(lay.cell);
+
+    cache.clear();
+}
+
+QRect YearView::monthRect(int month) const {
+    const int i = month - 1;
+    const int x = lay.left + (i % 3) * (lay.monthW + lay.gap);
+    const int y = HEADER + (i / 3) * (lay.monthH + lay.gap);
+    return QRect(x, y, lay.monthW, lay.monthH);
+}
+
+const QPixmap& YearView::yearPixmap(int year) {
+    auto it = cache.find(year);
+    if (it != cache.end()) return *it;
+
+    if (!totals.contains(year) && !requested.contains(year)) {
+        requested.insert(year);
+        emit yearNeeded(year);
+    }
+
+    const qreal dpr = devicePixelRatioF();
+    QPixmap pm(QSize(viewport()->width(), lay.yearH) * dpr);
+    pm.setDevicePixelRatio(dpr);
+    pm.fill(BG);
+
+    QPainter p(&pm);
+    p.setFont(font());
+    renderYear(&p, year);
+    p.end();
+
+    return *cache.insert(year, pm);
+}
+
+void YearView::renderYear(QPainter *p, int year) const {
+    p->setPen(TEXT);
+    QFont f = p->font();
+    f.setBold(true);
+    p->setFont(f);
+    p->drawText(QRect(lay.left, 0, lay.monthW * 3, HEADER), Qt::AlignLeft | Qt::AlignVCenter,
+                QString("%1年").arg(year));
+    f.setBold(false);
+    f.setPixelSize(qMax(9, MONTH_TITLE - 5));
+    p->setFont(f);
+
+    const auto it = totals.constFind(year);
+    const DailyTotals *t = (it != totals.constEnd()) ? &*it : nullptr;
+
+    p->setRenderHint(QPainter::Antialiasing, true);
+    for (int m = 1; m <= 12; ++m) {
+        const QRect mr = monthRect(m);
+        p->setPen(DIM);
+        p->drawText(QRect(mr.left(), mr.top(), mr.width(), MONTH_TITLE), Qt::AlignLeft | Qt::AlignVCenter,
+                    QString("%1月").arg(m));
+
+        const QDate first(year, m, 1);
+        const int offset = first.dayOfWeek() % 7;   // 週日開頭，和月曆一致
+        for (int d = 1; d <= first.daysInMonth(); ++d) {
+            const QDate date(year, m, d);
+            const int slot = offset + d - 1;
+            const QRect cell(mr.left() + (slot % 7) * lay.cell,
+                             mr.top() + MONTH_TITLE + (slot / 7) * lay.cell,
+                             lay.cell, lay.cell);
+            const QRect box = cell.adjusted(1, 1, -1, -1);
+
+            const int level = t ? t->level(date, DotCalendar::HeatLevels) : 0;
+            p->setPen(Qt::NoPen);
+            p->setBrush(level > 0 ? DotCalendar::heatColor(level) : EMPTY);
+            p->drawRoundedRect(box, 2, 2);
+
+            if (date == today) {
+                p->setPen(QPen(ACCENT, 1.5));
+                p->setBrush(Qt::NoBrush);
+                p->drawRoundedRect(box, 2, 2);
+            }
+        }
+    }
+}
+
+void YearView::paintEvent(QPaintEvent *event) {
+    QPainter p(viewport());
+    p.fillRect(event->rect(), BG);
+
+    const int top = verticalScrollBar()->value();
+    const int from = qMax(firstYear, firstYear + top / qMax(1, lay.yearH));
+    for (int y = from; y <= lastYear; ++y) {
+        const int ty = yearTop(y) - top;
+        if (ty >= viewport()->height()) break;
+        if (ty + lay.yearH <= event->rect().top() || ty >= event->rect().bottom() + 1) continue;
+        p.drawPixmap(0, ty, yearPixmap(y));
+    }
+}
+
+void YearView::resizeEvent(QResizeEvent *event) {
+    QAbstractScrollArea::resizeEvent(event);
+    const int year = firstYear + verticalScrollBar()->value() / qMax(1, lay.yearH);
+    relayout();
+    scrollToYear(year);
+}
+
+void YearView::scrollContentsBy(int, int) {
+    viewport()->update();
+}
+
+void YearView::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() != Qt::LeftButton) return;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    const QPoint pos = event->position().toPoint();
+#else
+    const QPoint pos = event->pos();
+#endif
+    const int absY = pos.y() + verticalScrollBar()->value();
+    const int year = firstYear + absY / qMax(1, lay.yearH);
+    if (year < firstYear || year > lastYear) return;
+
+    const QPoint local(pos.x(), absY - yearTop(year));
+    for (int m = 1; m <= 12; ++m) {
+        const QRect mr = monthRect(m);
+        if (!mr.contains(local)) continue;
+
+        const int row = (local.y() - mr.top() - MONTH_TITLE) / lay.cell;
+        const int col = (local.x() - mr.left()) / lay.cell;
+        if (local.y() < mr.top() + MONTH_TITLE || row < 0 || col < 0 || col > 6) return;
+
+        const QDate first(year, m, 1);
+        const int day = row * 7 + col - first.dayOfWeek() % 7 + 1;
+        if (day >= 1 && day <= first.daysInMonth())
+            emit dateClicked(QDate(year, m, day));
+        return;
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <QAbstractScrollArea>
+#include <QDate>
+#include <QHash>
+#include <QPixmap>
+#include <QSet>
+
+#include "dailytotals.h"
+
+// ✅ 年度總覽：每年 12 個小月曆（365 格），依每日支出上熱度色，可上下捲動好幾年
+// 每年畫成一張 pixmap 快取，捲動時只貼圖；那年資料變了才重畫
+class YearView : public QAbstractScrollArea {
+    Q_OBJECT
+public:
+    explicit YearView(QWidget *parent = nullptr);
+
+    void setYearRange(int first, int last);
+    void scrollToYear(int year);
+
+    void setDailyTotals(const DailyTotals& t);
+    void setDayTotals(const QDate& d, double income, double expense);
+
+signals:
+    void dateClicked(const QDate& d);
+    // 捲到還沒有資料的年份；由外面去要 DailyTotals
+    void yearNeeded(int year);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;
+
+private:
+    struct Layout {
+        int cell = 0;       // 一天的邊長
+        int gap = 0;        // 月與月之間
+        int monthW = 0;
+        int monthH = 0;
+        int yearH = 0;
+        int left = 0;
+    };
+
+    void relayout();
+    int yearTop(int year) const { return (year - firstYear) * lay.yearH; }
+    QRect monthRect(int month) const;      // 以年區塊左上角為原點
+    const QPixmap& yearPixmap(int year);
+    void renderYear(QPainter *p, int year) const;
+    void invalidateYear(int year);
+
+    int firstYear;
+    int lastYear;
+    Layout lay;
+
+    QHash<int, DailyTotals> totals;
+    QSet<int> requested;
+    QHash<int, QPixmap> cache;
+    QDate today;
+};
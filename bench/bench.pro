@@ -0,0 +1,14 @@
+QT = core
+CONFIG += c++17 console
+CONFIG -= app_bundle
+TEMPLATE = app
+TARGET = calendar-bench
+
+include(../core/core.pri)
+
+SOURCES += \
+    main.cpp \
+    datagen.cpp
+
+HEADERS += \
+    datagen.h
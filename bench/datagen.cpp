@@ -0,0 +1,59 @@
+#include "datagen.h"
+#include "account.h"
+#include "todostore.h"
+#include "categorytable.h"
+
+#include <QRandomGenerator>
+
+DataGenStats generateData(const DataGenConfig &cfg)
+{
+    DataGenStats st;
+    QRandomGenerator rng(cfg.seed);
+
+    const QStringList &cats = CategoryTable::builtins();
+    const QDate end = cfg.start.addYears(cfg.years);
+
+    for (QDate d = cfg.start; d < end; d = d.addDays(1)) {
+        st.days++;
+        if (rng.generateDouble() > cfg.fillRatio) continue;
+
+        // 記帳：大多是支出，偶爾一筆收入；每月 1 號設預算
+        QVector<AccountItem> items;
+        const int n = qMax(1, cfg.entriesPerDay + rng.bounded(-2, 3));
+        for (int i = 0; i < n; ++i) {
+            AccountItem item;
+            item.date = d;
+            bool income = rng.bounded(10) == 0;
+            item.type = income ? EntryType::Income : EntryType::Expense;
+            item.setCategory(income ? cats[7 + rng.bounded(3)] : cats[rng.bounded(7)]);
+            item.amount = income ? 1000 + rng.bounded(50000) : 10 + rng.bounded(2000);
+            item.note = QString("note %1").arg(rng.bounded(1000));
+            items.append(item);
+        }
+        double budget = (d.day() == 1) ? 30000 : 0;
+        if (Account::writeDayFile(d, items, budget)) {
+            st.ledgerFiles++;
+            st.entries += items.size();
+        }
+
+        if (cfg.todosPerDay <= 0) continue;
+
+        QVector<Todo> todos;
+        QVector<bool> done;
+        for (int i = 0; i < cfg.todosPerDay; ++i) {
+            Todo td;
+            td.title = QString("待辦 %1").arg(rng.bounded(100));
+            td.allDay = rng.bounded(2) == 0;
+            int h = 8 + rng.bounded(10);
+            td.start = QDateTime(d, QTime(h, 0));
+            td.end = QDateTime(d, QTime(h + 1, 0));
+            todos.append(td);
+            done.append(rng.bounded(2) == 0);
+        }
+        if (TodoStore::writeDayFile(d, todos, done)) {
+            st.todoFiles++;
+            st.todos += todos.size();
+        }
+    }
+    return st;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <QDate>
+
+// ✅ 產生固定種子的假資料：data/yyyy-MM-dd.json 與 .todo.json
+struct DataGenConfig {
+    QDate start = QDate(2015, 1, 1);
+    int years = 10;
+    int entriesPerDay = 5;
+    int todosPerDay = 1;
+    double fillRatio = 0.85;   // 有資料的日子比例
+    quint32 seed = 42;
+};
+
+struct DataGenStats {
+    int days = 0;
+    int ledgerFiles = 0;
+    int todoFiles = 0;
+    qint64 entries = 0;
+    qint64 todos = 0;
+};
+
+DataGenStats generateData(const DataGenConfig &cfg);
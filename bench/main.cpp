@@ -0,0 +1,328 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <cstdio>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "datagen.h"
+#include "account.h"
+#include "bulkimporter.h"
+#include "daycache.h"
+#include "datepresence.h"
+#include "ledgerquery.h"
+#include "todostore.h"
+#include "todointervals.h"
+
+// ✅ 效能量測：產生假資料後跑熱點路徑，結果輸出成 JSON
+
+namespace {
+
+QJsonArray results;
+
+template <typename F>
+void bench(const QString &name, int iterations, F &&fn)
+{
+    QElapsedTimer t;
+    t.start();
+    for (int i = 0; i < iterations; ++i)
+        fn(i);
+    const double ms = t.nsecsElapsed() / 1e6;
+
+    QJsonObject r;
+    r["name"] = name;
+    r["iterations"] = iterations;
+    r["total_ms"] = ms;
+    r["per_op_us"] = iterations > 0 ? ms * 1000.0 / iterations : 0.0;
+    results.append(r);
+
+    std::fprintf(stderr, "%-36s %8d  %10.3f ms  %10.3f us/op\n",
+                 qPrintable(name), iterations, ms, iterations > 0 ? ms * 1000.0 / iterations : 0.0);
+}
+
+void note(const QString &name, const QJsonObject &values)
+{
+    QJsonObject r = values;
+    r["name"] = name;
+    results.append(r);
+}
+
+qint64 heapInUse()
+{
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 33)
+    return qint64(mallinfo2().uordblks);
+#endif
+#endif
+    return -1;
+}
+
+QDate monthAt(const QDate &start, int i)
+{
+    return start.addMonths(i);
+}
+
+// 舊版 AccountItem：類別與類型都是字串
+struct LegacyItem {
+    QDate date;
+    QString category;
+    int amount = 0;
+    QString type;
+    QString note;
+};
+
+void benchItemLayout(int n)
+{
+    const QStringList &cats = CategoryTable::builtins();
+
+    qint64 before = heapInUse();
+    QVector<LegacyItem> legacy;
+    legacy.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        LegacyItem it;
+        // 從 JSON 讀進來的字串各自配置，這裡照樣複製一份
+        it.category = QString::fromUtf8(cats[i % cats.size()].toUtf8());
+        it.type = QString::fromLatin1((i % 10 == 0) ? "income" : "expense");
+        it.amount = i % 2000;
+        legacy.append(it);
+    }
+    qint64 legacyHeap = heapInUse() - before;
+
+    before = heapInUse();
+    QVector<AccountItem> compact;
+    compact.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        AccountItem it;
+        it.setCategory(cats[i % cats.size()]);
+        it.type = (i % 10 == 0) ? EntryType::Income : EntryType::Expense;
+        it.amount = i % 2000;
+        compact.append(it);
+    }
+    qint64 compactHeap = heapInUse() - before;
+
+    QJsonObject mem;
+    mem["items"] = n;
+    mem["legacy_sizeof"] = int(sizeof(LegacyItem));
+    mem["compact_sizeof"] = int(sizeof(AccountItem));
+    mem["legacy_heap_bytes"] = double(legacyHeap);     // -1：這個平台量不到
+    mem["compact_heap_bytes"] = double(compactHeap);
+    note("item_layout.memory", mem);
+
+    volatile double sink = 0;
+    bench("item_layout.legacy_expense_sum", 20, [&](int){
+        double sum = 0;
+        for (const auto &it : legacy)
+            if (it.type == "expense") sum += it.amount;
+        sink = sink + sum;
+    });
+    bench("item_layout.compact_expense_sum", 20, [&](int){
+        double sum = 0;
+        for (const auto &it : compact)
+            if (it.type == EntryType::Expense) sum += it.amount;
+        sink = sink + sum;
+    });
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("calendar-bench");
+
+    QCommandLineParser p;
+    p.setApplicationDescription("Calendar hot-path benchmarks");
+    p.addHelpOption();
+    p.addOption({"years", "Years of synthetic data.", "n", "10"});
+    p.addOption({"per-day", "Ledger entries per day.", "n", "5"});
+    p.addOption({"todos-per-day", "Todos per day.", "n", "1"});
+    p.addOption({"seed", "Generator seed.", "n", "42"});
+    p.addOption({"csv-rows", "Rows in the synthetic bank statement to import.", "n", "1000000"});
+    p.addOption({"out", "Write JSON results to this file (default: stdout).", "file"});
+    p.addOption({"data-dir", "Generate into this directory instead of a temp dir.", "dir"});
+    p.process(app);
+
+    DataGenConfig cfg;
+    cfg.years = p.value("years").toInt();
+    cfg.entriesPerDay = p.value("per-day").toInt();
+    cfg.todosPerDay = p.value("todos-per-day").toInt();
+    cfg.seed = p.value("seed").toUInt();
+
+    QTemporaryDir tmp;
+    const QString root = p.isSet("data-dir") ? p.value("data-dir") : tmp.path();
+    QDir().mkpath(root);
+    QDir::setCurrent(root);   // 程式都用相對路徑 data/
+
+    QElapsedTimer genTimer;
+    genTimer.start();
+    DataGenStats st = generateData(cfg);
+
+    QJsonObject gen;
+    gen["days"] = st.days;
+    gen["ledger_files"] = st.ledgerFiles;
+    gen["todo_files"] = st.todoFiles;
+    gen["entries"] = double(st.entries);
+    gen["todos"] = double(st.todos);
+    gen["total_ms"] = genTimer.nsecsElapsed() / 1e6;
+    note("generate", gen);
+
+    const int months = cfg.years * 12;
+    const QDate last = cfg.start.addYears(cfg.years).addDays(-1);
+
+    // --- Account::loadFromFile ---
+    DayCache::instance().clear();
+    bench("account.load.cold", st.days, [&](int i){
+        Account a;
+        a.loadFromFile(cfg.start.addDays(i));
+    });
+    const int warmDays = qMin(st.days, DayCache::instance().capacity());
+    bench("account.load.warm", warmDays * 100, [&](int i){
+        Account a;
+        a.loadFromFile(last.addDays(-(i % warmDays)));
+    });
+
+    // --- 月統計：第一次要建摘要，之後只讀摘要 ---
+    Account acc;
+    bench("account.monthlyExpense.build_summary", months, [&](int i){
+        QDate m = monthAt(cfg.start, i);
+        acc.monthlyExpense(m.year(), m.month());
+    });
+    bench("account.monthlyExpense", months, [&](int i){
+        QDate m = monthAt(cfg.start, i);
+        acc.monthlyExpense(m.year(), m.month());
+    });
+
+    acc.setMonthlyBudget(30000);
+    bench("account.isBudgetWarning", months, [&](int i){
+        QDate m = monthAt(cfg.start, i);
+        acc.isBudgetWarning(m.year(), m.month());
+    });
+
+    // --- 區間統計 ---
+    bench("range.quarter", months / 3, [&](int i){
+        QDate from = monthAt(cfg.start, i * 3);
+        LedgerQuery::aggregate(from, from.addMonths(3).addDays(-1));
+    });
+    bench("range.all_years.columnar_build", 1, [&](int){
+        LedgerQuery::aggregate(cfg.start, last);
+    });
+    bench("range.all_years", 20, [&](int){
+        LedgerQuery::aggregate(cfg.start, last);
+    });
+
+    // --- 行事曆白點：每天 stat 兩次 vs. bitmap ---
+    bench("marks.month_scan.stat", months, [&](int i){
+        QDate first = monthAt(cfg.start, i);
+        QSet<QDate> marks;
+        for (int d = 1; d <= first.daysInMonth(); ++d) {
+            QDate date(first.year(), first.month(), d);
+            if (QFile::exists(Account::filePath(date)) || QFile::exists(TodoStore::filePath(date)))
+                marks.insert(date);
+        }
+    });
+    DatePresence presence("data");
+    bench("marks.month_scan.bitmap", months, [&](int i){
+        QDate first = monthAt(cfg.start, i);
+        presence.marksForMonth(first.year(), first.month());
+    });
+
+    // --- Todo 讀寫 ---
+    bench("todo.read", st.days, [&](int i){
+        QVector<Todo> todos;
+        QVector<bool> done;
+        TodoStore::readDayFile(cfg.start.addDays(i), todos, done);
+    });
+    const int saveDays = qMin(st.days, 365);
+    bench("todo.write", saveDays, [&](int i){
+        QDate d = last.addDays(-i);
+        QVector<Todo> todos;
+        QVector<bool> done;
+        TodoStore::readDayFile(d, todos, done);
+        TodoStore::writeDayFile(d, todos, done);
+    });
+
+    // --- 待辦區間樹：重疊查詢 / 找空檔 ---
+    bench("todo_intervals.build", 1, [&](int){
+        TodoIntervals::instance().build();
+    });
+    bench("todo_intervals.overlap_day", st.days, [&](int i){
+        const QDate d = cfg.start.addDays(i);
+        TodoIntervals::instance().overlapping(QDateTime(d, QTime(9, 0)), QDateTime(d, QTime(18, 0)));
+    });
+    bench("todo_intervals.free_slots_4w", qMin(st.days, 365), [&](int i){
+        const QDateTime from(last.addDays(-i), QTime(9, 0));
+        TodoIntervals::instance().freeSlots(from, from.addDays(28), 60);
+    });
+
+    // --- 對帳單匯入：一列一筆，依日期排序 ---
+    {
+        const int rows = p.value("csv-rows").toInt();
+        const QString csv = QDir(root).filePath("statement.csv");
+        QFile f(csv);
+        if (f.open(QIODevice::WriteOnly)) {
+            f.write("日期,摘要,金額\n");
+            const int perDay = qMax(1, rows / qMax(1, st.days));
+            for (int i = 0; i < rows; ++i) {
+                const QDate d = cfg.start.addDays(i / perDay);
+                f.write(QString("%1,\"轉帳 %2\",%3\n")
+                            .arg(d.toString("yyyy/MM/dd")).arg(i).arg((i % 7 == 0) ? 5000 : -(i % 900 + 1))
+                            .toUtf8());
+            }
+            f.close();
+
+            BulkImporter importer;
+            importer.importBankCsv(csv);
+            const ImportStats &is = importer.stats();
+
+            QJsonObject imp;
+            imp["rows"] = double(is.rows);
+            imp["days_written"] = is.daysWritten;
+            imp["total_ms"] = double(is.elapsedMs);
+            imp["rows_per_sec"] = is.rowsPerSecond();
+            note("import.bank_csv", imp);
+            std::fprintf(stderr, "%-36s %8lld  %10lld ms  %10.0f rows/s\n", "import.bank_csv",
+                         static_cast<long long>(is.rows), static_cast<long long>(is.elapsedMs), is.rowsPerSecond());
+            QFile::remove(csv);
+        }
+    }
+
+    benchItemLayout(qMax(1, int(st.entries)));
+
+    QJsonObject cache;
+    cache["hits"] = double(DayCache::instance().hits());
+    cache["misses"] = double(DayCache::instance().misses());
+    cache["evictions"] = double(DayCache::instance().evictions());
+    note("day_cache", cache);
+
+    QJsonObject config;
+    config["years"] = cfg.years;
+    config["entries_per_day"] = cfg.entriesPerDay;
+    config["todos_per_day"] = cfg.todosPerDay;
+    config["seed"] = double(cfg.seed);
+    config["csv_rows"] = p.value("csv-rows").toInt();
+
+    QJsonObject out;
+    out["config"] = config;
+    out["results"] = results;
+    const QByteArray json = QJsonDocument(out).toJson();
+
+    if (p.isSet("out")) {
+        QFile f(p.value("out"));
+        if (!f.open(QIODevice::WriteOnly)) {
+            std::fprintf(stderr, "cannot write %s\n", qPrintable(p.value("out")));
+            return 1;
+        }
+        f.write(json);
+    } else {
+        std::fwrite(json.constData(), 1, size_t(json.size()), stdout);
+    }
+    return 0;
+}
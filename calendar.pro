@@ -1,18 +1,8 @@
-QT += widgets
-CONFIG += c++17
-TEMPLATE = app
-TARGET = calendar
+TEMPLATE = subdirs
 
-SOURCES += \
-    account.cpp \
-    main.cpp \
-    mainwindow.cpp \
-    dotcalendar.cpp \
-    addentrydialog.cpp
+# ✅ core：不含 GUI 的資料層（只用 QtCore），其餘都連結它
+SUBDIRS = core app cli bench
 
-HEADERS += \
-    account.h \
-    mainwindow.h \
-    dotcalendar.h \
-    addentrydialog.h \
-    models.h
+app.depends = core
+cli.depends = core
+bench.depends = core
@@ -0,0 +1,10 @@
+QT = core
+CONFIG += c++17 console
+CONFIG -= app_bundle
+TEMPLATE = app
+TARGET = calendar-cli
+
+include(../core/core.pri)
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,461 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <cstdio>
+
+#include "account.h"
+#include "bulkimporter.h"
+#include "journal.h"
+#include "ledgerquery.h"
+#include "todostore.h"
+#include "trace.h"
+
+#ifdef CALENDAR_HAVE_SQLITE
+#include "sqlitedaystore.h"
+#endif
+
+// ✅ calendar-cli：不開視窗的批次工具（匯入、月/年報表、資料檢查）
+
+namespace {
+
+bool jsonOutput = false;
+
+void out(const QString &s)
+{
+    std::fprintf(stdout, "%s\n", qPrintable(s));
+}
+
+void err(const QString &s)
+{
+    std::fprintf(stderr, "%s\n", qPrintable(s));
+}
+
+void printJson(const QJsonObject &o)
+{
+    const QByteArray json = QJsonDocument(o).toJson();
+    std::fwrite(json.constData(), 1, size_t(json.size()), stdout);
+}
+
+// 日檔名：yyyy-MM-dd.json / yyyy-MM-dd.todo.json
+QDate dateOfFile(const QString &name)
+{
+    return QDate::fromString(name.left(10), "yyyy-MM-dd");
+}
+
+bool readJson(const QString &path, QJsonObject &root, QString *error = nullptr)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (error) *error = f.errorString();
+        return false;
+    }
+    QJsonParseError pe;
+    QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &pe);
+    if (pe.error != QJsonParseError::NoError || !doc.isObject()) {
+        if (error) *error = pe.error != QJsonParseError::NoError ? pe.errorString() : "not an object";
+        return false;
+    }
+    root = doc.object();
+    return true;
+}
+
+QJsonObject totalsToJson(const RangeTotals &t)
+{
+    QJsonObject cats;
+    for (auto it = t.categories.cbegin(); it != t.categories.cend(); ++it) {
+        QJsonObject c;
+        c["income"] = it->income;
+        c["expense"] = it->expense;
+        c["count"] = it->count;
+        cats[it.key()] = c;
+    }
+    QJsonObject o;
+    o["income"] = t.income;
+    o["expense"] = t.expense;
+    o["net"] = t.net();
+    o["count"] = t.count;
+    o["categories"] = cats;
+    return o;
+}
+
+void printTotals(const QString &label, const RangeTotals &t)
+{
+    out(QString("%1  收入 %2  支出 %3  淨額 %4  筆數 %5")
+            .arg(label).arg(t.income, 0, 'f', 0).arg(t.expense, 0, 'f', 0)
+            .arg(t.net(), 0, 'f', 0).arg(t.count));
+    for (auto it = t.categories.cbegin(); it != t.categories.cend(); ++it)
+        out(QString("  %1\t收入 %2\t支出 %3\t%4 筆")
+                .arg(it.key()).arg(it->income, 0, 'f', 0).arg(it->expense, 0, 'f', 0).arg(it->count));
+}
+
+// ===== report =====
+int cmdReport(const QStringList &args)
+{
+    if (args.size() != 2) {
+        err("usage: calendar-cli report month YYYY-MM | report year YYYY");
+        return 2;
+    }
+
+    QDate from, to;
+    if (args[0] == "month") {
+        from = QDate::fromString(args[1] + "-01", "yyyy-MM-dd");
+        to = from.isValid() ? from.addMonths(1).addDays(-1) : QDate();
+    } else if (args[0] == "year") {
+        bool ok = false;
+        int y = args[1].toInt(&ok);
+        if (ok) {
+            from = QDate(y, 1, 1);
+            to = QDate(y, 12, 31);
+        }
+    }
+    if (!from.isValid() || !to.isValid()) {
+        err(QString("invalid period: %1 %2").arg(args[0], args[1]));
+        return 2;
+    }
+
+    // 年報表逐月列出，月份本身用同一份月摘要
+    QVector<QPair<QString, RangeTotals>> rows;
+    if (args[0] == "year") {
+        for (QDate m = from; m <= to; m = m.addMonths(1))
+            rows.append({m.toString("yyyy-MM"), LedgerQuery::month(m.year(), m.month())});
+    }
+    const RangeTotals total = LedgerQuery::aggregate(from, to);
+
+    if (jsonOutput) {
+        QJsonObject o = totalsToJson(total);
+        o["from"] = from.toString(Qt::ISODate);
+        o["to"] = to.toString(Qt::ISODate);
+        if (!rows.isEmpty()) {
+            QJsonObject months;
+            for (const auto &r : rows)
+                months[r.first] = totalsToJson(r.second);
+            o["months"] = months;
+        }
+        printJson(o);
+    } else {
+        for (const auto &r : rows)
+            out(QString("%1  收入 %2  支出 %3  淨額 %4")
+                    .arg(r.first).arg(r.second.income, 0, 'f', 0)
+                    .arg(r.second.expense, 0, 'f', 0).arg(r.second.net(), 0, 'f', 0));
+        printTotals(args[1], total);
+    }
+    return 0;
+}
+
+// ===== import =====
+// 舊版 todos.txt（.txt）或銀行對帳單（.csv）：串流讀取，每天只寫一次
+int importFile(const QString &path)
+{
+    BulkImporter importer;
+    importer.setProgress([](const ImportStats &st) {
+        const double pct = st.totalBytes > 0 ? st.bytesRead * 100.0 / st.totalBytes : 100.0;
+        std::fprintf(stderr, "\r%5.1f%%  %lld rows  %.0f rows/s", pct,
+                     static_cast<long long>(st.rows), st.rowsPerSecond());
+    });
+
+    const bool ok = path.endsWith(".csv", Qt::CaseInsensitive)
+                        ? importer.importBankCsv(path)
+                        : importer.importLegacyTodos(path);
+    std::fprintf(stderr, "\n");
+    if (!ok) {
+        err(importer.errorString());
+        return 2;
+    }
+
+    const ImportStats &st = importer.stats();
+    for (const QString &w : importer.warnings())
+        err(w);
+
+    if (jsonOutput) {
+        QJsonObject o;
+        o["rows"] = double(st.rows);
+        o["imported"] = double(st.imported);
+        o["skipped"] = double(st.skipped);
+        o["days_written"] = st.daysWritten;
+        o["bytes"] = double(st.bytesRead);
+        o["total_ms"] = double(st.elapsedMs);
+        o["rows_per_sec"] = st.rowsPerSecond();
+        printJson(o);
+    } else {
+        out(QString("imported %1 of %2 rows into %3 day files (%4 ms, %5 rows/s, %6 skipped)")
+                .arg(st.imported).arg(st.rows).arg(st.daysWritten).arg(st.elapsedMs)
+                .arg(st.rowsPerSecond(), 0, 'f', 0).arg(st.skipped));
+    }
+    return st.skipped > 0 ? 1 : 0;
+}
+
+// 把另一個資料夾的日檔併進目前的資料：每天只讀一次、寫一次
+int cmdImport(const QStringList &args, const QString &startDir)
+{
+    if (args.size() != 1) {
+        err("usage: calendar-cli import <dir | todos.txt | statement.csv>");
+        return 2;
+    }
+
+    const QString path = QDir(startDir).absoluteFilePath(args[0]);
+    if (QFileInfo(path).isFile())
+        return importFile(path);
+
+    QDir src(path);
+    if (src.exists("data")) src.cd("data");
+    if (!src.exists()) {
+        err(QString("no such directory: %1").arg(args[0]));
+        return 2;
+    }
+    if (src.absolutePath() == QDir("data").absolutePath()) {
+        err("refusing to import a data directory into itself");
+        return 2;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int ledgerDays = 0, todoDays = 0, entries = 0, todos = 0, failed = 0;
+
+    const QStringList files = src.entryList({"????-??-??.json", "????-??-??.todo.json"},
+                                            QDir::Files, QDir::Name);
+    for (const QString &name : files) {
+        const QDate date = dateOfFile(name);
+        QJsonObject root;
+        QString error;
+        if (!date.isValid() || !readJson(src.filePath(name), root, &error)) {
+            err(QString("skip %1: %2").arg(name, error.isEmpty() ? "bad file name" : error));
+            failed++;
+            continue;
+        }
+
+        if (name.endsWith(".todo.json")) {
+            QVector<Todo> list;
+            QVector<bool> done;
+            TodoStore::load(date, list, done);
+
+            QVector<QJsonObject> ops;
+            for (const auto &v : root["todos"].toArray()) {
+                bool d = false;
+                Todo td = TodoStore::fromJson(v.toObject(), date, &d);
+                list.append(td);
+                done.append(d);
+                ops.append(Journal::opAdd(TodoStore::toJson(td, d)));
+            }
+            if (ops.isEmpty()) continue;
+            if (!TodoStore::save(date, list, done, ops)) {
+                err(QString("write failed: %1").arg(TodoStore::filePath(date)));
+                failed++;
+                continue;
+            }
+            todoDays++;
+            todos += ops.size();
+        } else {
+            Account acc;
+            const bool existed = acc.loadFromFile(date);
+            if (!existed && root.contains("monthly_budget"))
+                acc.setMonthlyBudget(root["monthly_budget"].toDouble());
+
+            const QJsonArray arr = root["account"].toArray();
+            for (const auto &v : arr)
+                acc.addItem(Account::itemFromJson(v.toObject(), date));
+            if (arr.isEmpty() && existed) continue;
+            if (!acc.saveToFile(date)) {
+                err(QString("write failed: %1").arg(Account::filePath(date)));
+                failed++;
+                continue;
+            }
+            ledgerDays++;
+            entries += arr.size();
+        }
+    }
+
+    const double ms = timer.nsecsElapsed() / 1e6;
+    if (jsonOutput) {
+        QJsonObject o;
+        o["files"] = files.size();
+        o["ledger_days"] = ledgerDays;
+        o["todo_days"] = todoDays;
+        o["entries"] = entries;
+        o["todos"] = todos;
+        o["failed"] = failed;
+        o["total_ms"] = ms;
+        printJson(o);
+    } else {
+        out(QString("imported %1 entries over %2 days, %3 todos over %4 days (%5 ms, %6 failed)")
+                .arg(entries).arg(ledgerDays).arg(todos).arg(todoDays).arg(ms, 0, 'f', 1).arg(failed));
+    }
+    return failed > 0 ? 1 : 0;
+}
+
+// ===== check =====
+// 一次掃過 data/：JSON 壞檔、金額/類型不對、待辦結束早於開始
+int cmdCheck()
+{
+    QDir dir("data");
+    QJsonArray problems;
+    int files = 0, count = 0;
+
+    auto report = [&](const QString &file, const QString &what) {
+        count++;
+        if (jsonOutput) {
+            QJsonObject p;
+            p["file"] = file;
+            p["problem"] = what;
+            problems.append(p);
+        } else {
+            out(QString("%1: %2").arg(file, what));
+        }
+    };
+
+    const QStringList names = dir.entryList({"????-??-??.json", "????-??-??.todo.json"},
+                                            QDir::Files, QDir::Name);
+    for (const QString &name : names) {
+        files++;
+        const QString path = dir.filePath(name);
+        const QDate date = dateOfFile(name);
+        if (!date.isValid()) {
+            report(path, "file name is not a valid date");
+            continue;
+        }
+
+        QJsonObject root;
+        QString error;
+        if (!readJson(path, root, &error)) {
+            report(path, error);
+            continue;
+        }
+
+        if (name.endsWith(".todo.json")) {
+            const QJsonArray arr = root["todos"].toArray();
+            for (int i = 0; i < arr.size(); ++i) {
+                const QJsonObject o = arr[i].toObject();
+                const QDateTime s = QDateTime::fromString(o["start"].toString(), Qt::ISODate);
+                const QDateTime e = QDateTime::fromString(o["end"].toString(), Qt::ISODate);
+                if (o["title"].toString().trimmed().isEmpty())
+                    report(path, QString("todo #%1: empty title").arg(i));
+                if (!s.isValid() || !e.isValid())
+                    report(path, QString("todo #%1: invalid start/end").arg(i));
+                else if (e < s)
+                    report(path, QString("todo #%1: end before start").arg(i));
+            }
+        } else {
+            if (!root["account"].isArray()) {
+                report(path, "missing \"account\" array");
+                continue;
+            }
+            const QJsonArray arr = root["account"].toArray();
+            for (int i = 0; i < arr.size(); ++i) {
+                const QJsonObject o = arr[i].toObject();
+                const QJsonValue amount = o["amount"];
+                const QString type = o["type"].toString();
+                if (!amount.isDouble() || amount.toDouble() < 0
+                        || amount.toDouble() != double(amount.toInt()))
+                    report(path, QString("entry #%1: bad amount").arg(i));
+                if (type != "income" && type != "expense" && type != "other")
+                    report(path, QString("entry #%1: unknown type \"%2\"").arg(i).arg(type));
+            }
+        }
+    }
+
+    if (jsonOutput) {
+        QJsonObject o;
+        o["files"] = files;
+        o["problems"] = problems;
+        printJson(o);
+    } else {
+        out(QString("checked %1 files, %2 problems").arg(files).arg(count));
+    }
+    return count > 0 ? 1 : 0;
+}
+
+#ifdef CALENDAR_HAVE_SQLITE
+// 把 data/ 的 JSON 整批搬進 data/calendar.db（JSON 檔不動）
+// 已搬過的資料庫可能有更新的編輯，要 --overwrite 才會用 JSON 蓋掉
+int cmdMigrate(bool overwrite)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // 不讓建構時自動搬一次，否則新資料庫會搬兩次
+    SqliteDayStore db("data/calendar.db", false);
+    if (db.isMigrated() && !overwrite) {
+        err("data/calendar.db is already migrated; pass --overwrite to replace its contents with the JSON files");
+        return 1;
+    }
+
+    SqliteDayStore::MigrationStats st;
+    const bool ok = db.migrateFromJson(true, &st, [](int done, int total){
+        if (!jsonOutput) std::fprintf(stderr, "\r%d / %d", done, total);
+    });
+    if (!jsonOutput && st.ledgerDays + st.todoDays + st.budgets > 0) std::fprintf(stderr, "\n");
+
+    if (!ok) {
+        err(QString("migration failed: %1").arg(db.errorString()));
+        return 1;
+    }
+
+    if (jsonOutput) {
+        QJsonObject o;
+        o["ledgerDays"] = st.ledgerDays;
+        o["todoDays"] = st.todoDays;
+        o["entries"] = st.entries;
+        o["todos"] = st.todos;
+        o["budgets"] = st.budgets;
+        o["elapsedMs"] = double(timer.elapsed());
+        printJson(o);
+    } else {
+        out(QString("migrated %1 ledger days (%2 entries), %3 todo days (%4 todos), %5 budgets in %6 ms")
+                .arg(st.ledgerDays).arg(st.entries).arg(st.todoDays).arg(st.todos)
+                .arg(st.budgets).arg(timer.elapsed()));
+    }
+    return 0;
+}
+#endif
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("calendar-cli");
+
+    QCommandLineParser p;
+    p.setApplicationDescription("Calendar batch tool");
+    p.addHelpOption();
+    p.addOption({"data", "Directory that contains data/ (default: current directory).", "dir"});
+    p.addOption({"json", "Print results as JSON."});
+    p.addOption({"overwrite", "migrate: replace an already migrated database with the JSON files."});
+    p.addPositionalArgument("command", "import <dir|file.txt|file.csv> | report month YYYY-MM | report year YYYY | check | migrate");
+    p.process(app);
+
+    jsonOutput = p.isSet("json");
+    const QString startDir = QDir::currentPath();
+    if (p.isSet("data") && !QDir::setCurrent(p.value("data"))) {
+        err(QString("cannot enter %1").arg(p.value("data")));
+        return 2;
+    }
+
+    QStringList args = p.positionalArguments();
+    if (args.isEmpty()) p.showHelp(2);
+    const QString cmd = args.takeFirst();
+
+    int ret = 2;
+    if (cmd == "import")
+        ret = cmdImport(args, startDir);
+    else if (cmd == "report")
+        ret = cmdReport(args);
+    else if (cmd == "check")
+        ret = cmdCheck();
+#ifdef CALENDAR_HAVE_SQLITE
+    else if (cmd == "migrate")
+        ret = cmdMigrate(p.isSet("overwrite"));
+#endif
+    else
+        err(QString("unknown command: %1").arg(cmd));
+
+    // 匯入可能觸發日誌壓縮，寫完再離開
+    if (Journal::enabled()) Journal::instance().waitForCompaction();
+    Trace::instance().finish();
+    return ret;
+}
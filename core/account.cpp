@@ -0,0 +1,285 @@
+#include "account.h"
+#include "monthsummary.h"
+#include "daycache.h"
+#include "ledgerquery.h"
+#include "journal.h"
+#include "balanceindex.h"
+#include "searchindex.h"
+#include "daystore.h"
+#include "trace.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDir>
+#include <QDebug>
+
+Account::Account() {}
+
+// ✅ 異動紀錄只有 journal 用得到，沒開就不組 JSON
+void Account::addItem(const AccountItem &item)
+{
+    m_items.append(item);
+    if (Journal::enabled())
+        m_pending.append(Journal::opAdd(itemToJson(item)));
+}
+
+bool Account::removeAt(int index)
+{
+    if (index < 0 || index >= m_items.size()) return false;
+    m_items.removeAt(index);
+    if (Journal::enabled())
+        m_pending.append(Journal::opRemove(index));
+    return true;
+}
+
+bool Account::insertAt(int index, const AccountItem &item)
+{
+    if (index < 0 || index > m_items.size()) return false;
+    m_items.insert(index, item);
+    if (Journal::enabled())
+        m_pending.append(Journal::opInsert(index, itemToJson(item)));
+    return true;
+}
+
+void Account::clearDailyItems()
+{
+    m_items.clear();
+}
+
+double Account::dailyIncome() const
+{
+    double sum = 0;
+    for (const auto &item : m_items) {
+        if (item.type == EntryType::Income)
+            sum += item.amount;
+    }
+    return sum;
+}
+
+double Account::dailyExpense() const
+{
+    double sum = 0;
+    for (const auto &item : m_items) {
+        if (item.type == EntryType::Expense)
+            sum += item.amount;
+    }
+    return sum;
+}
+
+double Account::dailyNet() const
+{
+    return dailyIncome() - dailyExpense();
+}
+
+// ✅ 月統計改讀 data/summary_yyyy-MM.json，不再逐日開檔
+double Account::monthlyIncome(int year, int month) const
+{
+    return LedgerQuery::month(year, month).income;
+}
+
+double Account::monthlyExpense(int year, int month) const
+{
+    return LedgerQuery::month(year, month).expense;
+}
+
+void Account::setMonthlyBudget(double budget)
+{
+    m_monthlyBudget = budget;
+    if (Journal::enabled())
+        m_pending.append(Journal::opBudget(budget));
+}
+
+double Account::getMonthlyBudget() const
+{
+    return m_monthlyBudget;
+}
+
+bool Account::isBudgetWarning(int year, int month) const
+{
+    if (m_monthlyBudget <= 0) return false;
+
+    double expense = monthlyExpense(year, month);
+    return expense >= m_monthlyBudget * 0.8;
+}
+
+QString Account::filePath(const QDate &date)
+{
+    QDir dir("data");
+    if (!dir.exists())
+        dir.mkpath(".");
+
+    return QString("data/%1.json").arg(date.toString("yyyy-MM-dd"));
+}
+
+// 類別表滿了的紀錄沒有類別名稱，寫出去就會變成空字串，整天都不存
+static bool categoriesValid(const QDate &date, const QVector<AccountItem> &items)
+{
+    for (const auto &item : items) {
+        if (item.categoryId == CategoryTable::kInvalid) {
+            qWarning().noquote() << QString("ledger %1: entry without a category id, not saving")
+                                        .arg(date.toString(Qt::ISODate));
+            return false;
+        }
+    }
+    return true;
+}
+
+QJsonObject Account::itemToJson(const AccountItem &item)
+{
+    QJsonObject obj;
+    obj["type"] = (item.type == EntryType::Other && !item.typeName.isEmpty())
+                      ? item.typeName : entryTypeName(item.type);
+    obj["category"] = item.category();
+    obj["amount"] = item.amount;
+    obj["note"] = item.note;
+    return obj;
+}
+
+AccountItem Account::itemFromJson(const QJsonObject &obj, const QDate &date)
+{
+    AccountItem item;
+    item.date = date; // ✅ 讀檔時補上當天日期
+    const QString type = obj["type"].toString();
+    item.type = entryTypeFromName(type);
+    if (item.type == EntryType::Other) item.typeName = type;
+    item.setCategory(obj["category"].toString());
+    item.amount = obj["amount"].toInt();
+    item.note = obj["note"].toString();
+    return item;
+}
+
+// ✅ 只讀日檔本身（不經快取、不套 journal）
+bool Account::readDayFile(const QDate &date, QVector<AccountItem> &items,
+                          bool &hasBudget, double &budget, QString *journalBatch)
+{
+    items.clear();
+    hasBudget = false;
+    if (journalBatch) journalBatch->clear();
+
+    QFile file(filePath(date));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const QByteArray data = file.readAll();
+    file.close();
+    TRACE_COUNT("file.opens", 1);
+    TRACE_COUNT("file.bytesRead", data.size());
+    TRACE_SCOPE_CAT("parse.ledgerDay", "parse");
+
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+
+    QJsonObject root = doc.object();
+    QJsonArray arr = root["account"].toArray();
+
+    for (const auto &v : arr)
+        items.append(itemFromJson(v.toObject(), date));
+
+    hasBudget = root.contains("monthly_budget");
+    if (hasBudget)
+        budget = root["monthly_budget"].toDouble();
+
+    if (journalBatch)
+        *journalBatch = root["journal_batch"].toString();
+
+    return true;
+}
+
+bool Account::writeDayFile(const QDate &date, const QVector<AccountItem> &items, double budget,
+                           const QString &journalBatch)
+{
+    if (!categoriesValid(date, items)) return false;
+
+    QJsonArray arr;
+    for (const auto &item : items)
+        arr.append(itemToJson(item));
+
+    QJsonObject root;
+    root["account"] = arr;
+    root["monthly_budget"] = budget;
+    if (!journalBatch.isEmpty())
+        root["journal_batch"] = journalBatch;
+
+    // ✅ QSaveFile：寫到暫存檔再原子改名，寫到一半當掉也不會留下壞檔
+    QSaveFile file(filePath(date));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    file.write(QJsonDocument(root).toJson());
+    return file.commit();
+}
+
+bool Account::loadFromFile(const QDate &date)
+{
+    TRACE_SCOPE("Account::loadFromFile");
+    clearDailyItems();
+    m_pending.clear();
+
+    // ✅ 先查快取，剛看過的日子不必再開檔
+    DayCache &cache = DayCache::instance();
+    DayRecord r;
+    if (cache.ledger(date, r)) {
+        m_items = r.items;
+        if (r.hasBudget)
+            m_monthlyBudget = r.monthlyBudget;
+        return r.ledgerExists;
+    }
+
+    bool hasBudget = false;
+    double budget = 0.0;
+    bool exists = DayStore::instance().loadLedger(date, m_items, hasBudget, budget);
+
+    if (hasBudget)
+        m_monthlyBudget = budget;
+
+    cache.putLedger(date, exists, m_items, hasBudget, m_monthlyBudget);
+    return exists;
+}
+
+bool Account::saveToFile(const QDate &date) const
+{
+    TRACE_SCOPE("Account::saveToFile");
+    if (!categoriesValid(date, m_items)) return false;
+
+    DayStore &store = DayStore::instance();
+    if (!store.saveLedger(date, m_items, m_monthlyBudget, m_pending))
+        return false;
+    m_pending.clear();
+
+    DayCache::instance().putLedger(date, true, m_items, true, m_monthlyBudget);
+    // 有索引的後端直接 GROUP BY，不用維護月摘要
+    if (!store.indexed())
+        MonthSummary::updateDay(date, m_items);
+    BalanceIndex::instance().setDay(date, qint64(dailyNet()));
+    SearchIndex::instance().updateLedger(date, m_items);
+    return true;
+}
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+// ✅ 覆蓋某筆（給右鍵修改用）
+bool Account::updateAt(int idx, const AccountItem &item)
+{
+    if (idx < 0 || idx >= m_items.size()) return false;
+    m_items[idx] = item;
+    if (Journal::enabled())
+        m_pending.append(Journal::opUpdate(idx, itemToJson(item)));
+    return true;
+}
+
+// ===== 月預算 =====
+bool Account::loadMonthlyBudget(int year, int month)
+{
+    double budget = 0.0;
+    if (!DayStore::instance().loadMonthBudget(year, month, budget)) return false;
+    m_monthlyBudget = budget;
+    return true;
+}
+
+bool Account::saveMonthlyBudget(int year, int month) const
+{
+    return DayStore::instance().saveMonthBudget(year, month, m_monthlyBudget);
+}
@@ -0,0 +1,85 @@
+#ifndef ACCOUNT_H
+#define ACCOUNT_H
+
+#include <QString>
+#include <QVector>
+#include <QDate>
+#include <QJsonObject>
+
+#include "models.h"
+#include "categorytable.h"
+
+// ✅ 緊湊版：類型用 enum、類別用 CategoryTable 的 16-bit id
+struct AccountItem {
+    QDate date;
+    int amount = 0;
+    quint16 categoryId = 0;
+    EntryType type = EntryType::Expense;
+    QString typeName;   // 讀到不認得的 type 字串（type 為 Other）時原樣保留，存檔寫回
+    QString note;
+
+    QString category() const { return CategoryTable::name(categoryId); }
+    // 類別表滿了回傳 false（categoryId 為 kInvalid，這筆不能存檔）
+    bool setCategory(const QString &name)
+    {
+        categoryId = CategoryTable::intern(name);
+        return categoryId != CategoryTable::kInvalid;
+    }
+};
+
+class Account
+{
+public:
+    Account();
+
+    void addItem(const AccountItem &item);
+    bool removeAt(int index);
+    bool insertAt(int index, const AccountItem &item);   // 復原刪除用
+    void clearDailyItems();
+
+    double dailyIncome() const;
+    double dailyExpense() const;
+    double dailyNet() const;
+
+    double monthlyIncome(int year, int month) const;
+    double monthlyExpense(int year, int month) const;
+
+    void setMonthlyBudget(double budget);
+    double getMonthlyBudget() const;
+    bool isBudgetWarning(int year, int month) const;
+
+    bool loadFromFile(const QDate &date);
+    bool saveToFile(const QDate &date) const;
+
+    const QVector<AccountItem>& getItems() const { return m_items; }
+
+    bool updateAt(int idx, const AccountItem& item);
+
+    // 異動已交給別的執行緒存檔時呼叫
+    void clearPendingOps() { m_pending.clear(); }
+    // 合併延遲寫入：earlier 的異動排在自己的前面
+    void prependPendingOps(const Account &earlier) { m_pending = earlier.m_pending + m_pending; }
+
+
+    bool loadMonthlyBudget(int year, int month);
+    bool saveMonthlyBudget(int year, int month) const;
+
+    // ✅ 日檔讀寫（data/yyyy-MM-dd.json），給 journal 壓縮等背景工作直接使用
+    static QString filePath(const QDate &date);
+    static QJsonObject itemToJson(const AccountItem &item);
+    static AccountItem itemFromJson(const QJsonObject &obj, const QDate &date);
+    // journalBatch：journal 壓縮寫入時記下的批次 id，重播時用來避免同一批套用兩次
+    static bool readDayFile(const QDate &date, QVector<AccountItem> &items,
+                            bool &hasBudget, double &budget, QString *journalBatch = nullptr);
+    static bool writeDayFile(const QDate &date, const QVector<AccountItem> &items, double budget,
+                             const QString &journalBatch = QString());
+
+private:
+    QVector<AccountItem> m_items;
+    double m_monthlyBudget = 0.0;
+
+    // 上次存檔後的異動（journal 模式只寫這些）
+    mutable QVector<QJsonObject> m_pending;
+};
+
+#endif // ACCOUNT_H
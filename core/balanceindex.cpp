@@ -0,0 +1,223 @@
+#include "balanceindex.h"
+#include "daystore.h"
+#include "monthsummary.h"
+#include "recurrence.h"
+
+#include <QDir>
+
+// 建樹 / 擴充時多留的天數，新增未來幾個月的記帳不必馬上重建
+static const int kSlackDays = 366;
+
+BalanceIndex& BalanceIndex::instance()
+{
+    static BalanceIndex idx;
+    return idx;
+}
+
+bool BalanceIndex::isReady() const
+{
+    QReadLocker lock(&m_lock);
+    return m_ready;
+}
+
+void BalanceIndex::invalidate()
+{
+    QWriteLocker lock(&m_lock);
+    m_ready = false;
+}
+
+void BalanceIndex::build()
+{
+    {
+        QWriteLocker lock(&m_lock);
+        m_building = true;
+    }
+
+    // 只列一次檔名，拿第一天與最後一天；之後全讀月摘要（有索引的後端一個查詢拿每日收支）
+    const DayStore &store = DayStore::instance();
+    QDate first, last;
+    if (store.indexed()) {
+        const QVector<QDate> days = store.days(DayStore::Ledger);
+        if (!days.isEmpty()) {
+            first = days.first();
+            last = days.last();
+        }
+    } else {
+        QDir dir("data");
+        const QStringList files = dir.entryList(QStringList{"????-??-??.json"}, QDir::Files, QDir::Name);
+        if (!files.isEmpty()) {
+            first = QDate::fromString(files.first().left(10), "yyyy-MM-dd");
+            last = QDate::fromString(files.last().left(10), "yyyy-MM-dd");
+        }
+    }
+
+    const QDate today = QDate::currentDate();
+    if (!first.isValid()) first = today;
+    if (!last.isValid() || last < today) last = today;
+
+    const qint64 base = QDate(first.year(), first.month(), 1).toJulianDay();
+    const int size = int(last.toJulianDay() - base + 1) + kSlackDays;
+
+    QVector<qint64> values(size, 0);
+    if (store.indexed()) {
+        const auto totals = store.dayTotals(QDate::fromJulianDay(base), last);
+        for (auto it = totals.constBegin(); it != totals.constEnd(); ++it) {
+            const qint64 i = it.key().toJulianDay() - base;
+            if (i >= 0 && i < size) values[int(i)] = qint64(it->income - it->expense);
+        }
+    } else {
+        for (QDate m(first.year(), first.month(), 1); m <= last; m = m.addMonths(1)) {
+            const MonthSummary s = MonthSummary::load(m.year(), m.month());
+            for (auto it = s.days().constBegin(); it != s.days().constEnd(); ++it) {
+                const qint64 i = QDate(m.year(), m.month(), it.key()).toJulianDay() - base;
+                if (i >= 0 && i < size) values[int(i)] = qint64(it->income - it->expense);
+            }
+        }
+    }
+
+    // 週期規則不寫日檔，展開整個範圍（含預留的天數）加上去
+    const auto recurring = RecurrenceStore::instance().ledgerTotals(QDate::fromJulianDay(base),
+                                                                    QDate::fromJulianDay(base + size - 1));
+    for (auto it = recurring.constBegin(); it != recurring.constEnd(); ++it) {
+        const qint64 i = it.key().toJulianDay() - base;
+        if (i >= 0 && i < size) values[int(i)] += qint64(it->income - it->expense);
+    }
+
+    QWriteLocker lock(&m_lock);
+    m_base = base;
+    m_values = values;
+    rebuild(base, size);
+
+    // 建樹期間存過檔的日子
+    for (auto it = m_pending.constBegin(); it != m_pending.constEnd(); ++it)
+        applyDay(it.key(), it.value());
+    m_pending.clear();
+    m_building = false;
+    m_ready = true;
+}
+
+// ✅ O(n) 建樹：每個節點把自己加到父節點
+void BalanceIndex::rebuild(qint64 base, int size)
+{
+    QVector<qint64> values(size, 0);
+    for (int i = 0; i < m_values.size(); ++i) {
+        const qint64 j = m_base + i - base;
+        if (j >= 0 && j < size) values[int(j)] = m_values[i];
+    }
+    m_base = base;
+    m_values = values;
+
+    m_tree.fill(0, size + 1);
+    for (int i = 1; i <= size; ++i) {
+        m_tree[i] += m_values[i - 1];
+        const int parent = i + (i & -i);
+        if (parent <= size) m_tree[parent] += m_tree[i];
+    }
+}
+
+void BalanceIndex::ensureRange(qint64 julianDay)
+{
+    const int size = m_values.size();
+    if (julianDay >= m_base && julianDay < m_base + size) return;
+
+    const qint64 oldBase = m_base, oldEnd = m_base + size;
+    const qint64 base = qMin(m_base, julianDay - kSlackDays);
+    const qint64 end = qMax(m_base + size, julianDay + 1 + kSlackDays);
+    rebuild(base, int(end - base));
+
+    addRecurring(base, oldBase - 1);
+    addRecurring(oldEnd, end - 1);
+}
+
+void BalanceIndex::addRecurring(qint64 from, qint64 to)
+{
+    if (to < from) return;
+    const auto totals = RecurrenceStore::instance().ledgerTotals(QDate::fromJulianDay(from),
+                                                                 QDate::fromJulianDay(to));
+    for (auto it = totals.constBegin(); it != totals.constEnd(); ++it) {
+        const qint64 i = it.key().toJulianDay() - m_base;
+        const qint64 net = qint64(it->income - it->expense);
+        if (i < 0 || i >= m_values.size() || net == 0) continue;
+        m_values[int(i)] += net;
+        add(int(i) + 1, net);
+    }
+}
+
+void BalanceIndex::add(int pos, qint64 delta)
+{
+    for (int i = pos; i < m_tree.size(); i += i & -i)
+        m_tree[i] += delta;
+}
+
+void BalanceIndex::applyDay(qint64 julianDay, qint64 net)
+{
+    ensureRange(julianDay);
+    const int i = int(julianDay - m_base);
+    const qint64 delta = net - m_values[i];
+    if (delta == 0) return;
+    m_values[i] = net;
+    add(i + 1, delta);
+}
+
+void BalanceIndex::setDay(const QDate &date, qint64 net)
+{
+    // 呼叫端給的是日檔的淨額，這天週期規則的部分在這裡補上
+    const auto recurring = RecurrenceStore::instance().ledgerTotals(date, date);
+    for (const DayTotal &t : recurring)
+        net += qint64(t.income - t.expense);
+
+    QWriteLocker lock(&m_lock);
+    if (!m_ready) {
+        if (m_building) m_pending.insert(date.toJulianDay(), net);
+        return;
+    }
+    applyDay(date.toJulianDay(), net);
+}
+
+qint64 BalanceIndex::prefix(qint64 julianDay) const
+{
+    qint64 pos = julianDay - m_base + 1;
+    if (pos <= 0) return 0;
+    if (pos > m_values.size()) pos = m_values.size();
+
+    qint64 sum = 0;
+    for (int i = int(pos); i > 0; i -= i & -i)
+        sum += m_tree[i];
+    return sum;
+}
+
+qint64 BalanceIndex::balanceAt(const QDate &date) const
+{
+    QReadLocker lock(&m_lock);
+    return prefix(date.toJulianDay());
+}
+
+qint64 BalanceIndex::rangeNet(const QDate &from, const QDate &to) const
+{
+    if (to < from) return 0;
+    QReadLocker lock(&m_lock);
+    return prefix(to.toJulianDay()) - prefix(from.toJulianDay() - 1);
+}
+
+QDate BalanceIndex::firstDate() const
+{
+    QReadLocker lock(&m_lock);
+    return QDate::fromJulianDay(m_base);
+}
+
+QVector<QPair<QDate, qint64>> BalanceIndex::series(const QDate &from, const QDate &to, int points) const
+{
+    QVector<QPair<QDate, qint64>> out;
+    if (to < from || points <= 0) return out;
+
+    const qint64 span = to.toJulianDay() - from.toJulianDay();
+    const int n = int(qMin<qint64>(points, span + 1));
+    out.reserve(n);
+
+    QReadLocker lock(&m_lock);
+    for (int k = 0; k < n; ++k) {
+        const qint64 jd = from.toJulianDay() + (n > 1 ? span * k / (n - 1) : 0);
+        out.append({QDate::fromJulianDay(jd), prefix(jd)});
+    }
+    return out;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <QDate>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QVector>
+
+// ✅ 每日淨額（收入 - 支出）的 Fenwick tree：任一天的累計餘額、任意區間淨額都是 O(log n)
+// 啟動時由月摘要建一次，之後每次 Account::saveToFile 更新那一天
+// 週期規則展開的收支也算在每天的淨額裡；規則一改就 invalidate，下次用到時重建
+class BalanceIndex
+{
+public:
+    static BalanceIndex& instance();
+
+    // 讀 data/ 的月摘要建樹；在背景執行緒呼叫
+    void build();
+    bool isReady() const;
+    void invalidate();
+
+    // 更新某天日檔的淨額（週期規則的部分這裡自己補）；建樹中先記下，建好後補上（還沒開始建就不必記，建的時候會讀到）
+    void setDay(const QDate &date, qint64 net);
+
+    // 到 date（含）為止的累計餘額
+    qint64 balanceAt(const QDate &date) const;
+    // [from, to] 的淨額
+    qint64 rangeNet(const QDate &from, const QDate &to) const;
+
+    QDate firstDate() const;
+
+    // 畫折線用：在 [from, to] 均勻取 points 個點的餘額
+    QVector<QPair<QDate, qint64>> series(const QDate &from, const QDate &to, int points) const;
+
+private:
+    BalanceIndex() = default;
+
+    qint64 prefix(qint64 julianDay) const;     // 不加鎖
+    void add(int pos, qint64 delta);
+    void rebuild(qint64 base, int size);       // 範圍不夠時重建
+    void ensureRange(qint64 julianDay);
+    void applyDay(qint64 julianDay, qint64 net);
+    void addRecurring(qint64 from, qint64 to);   // 擴充範圍後補上新涵蓋那幾天的週期收支
+
+    mutable QReadWriteLock m_lock;
+    bool m_ready = false;
+    bool m_building = false;
+    qint64 m_base = 0;          // tree[1] 對應的 julian day
+    QVector<qint64> m_tree;     // 1-based
+    QVector<qint64> m_values;   // 0-based，每天的淨額
+    QHash<qint64, qint64> m_pending;
+};
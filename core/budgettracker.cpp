@@ -0,0 +1,100 @@
+#include "budgettracker.h"
+#include "trace.h"
+
+#include <algorithm>
+
+BudgetTracker::BudgetTracker(QObject *parent)
+    : QObject(parent), m_thresholds{50, 80, 100}
+{
+}
+
+void BudgetTracker::setThresholds(const QVector<int> &percents)
+{
+    m_thresholds = percents;
+    std::sort(m_thresholds.begin(), m_thresholds.end());
+    m_level = levelFor(m_expense);
+}
+
+void BudgetTracker::setBudget(double budget, bool notify)
+{
+    if (budget == m_budget) return;
+    m_budget = budget;
+    update(notify);
+}
+
+void BudgetTracker::beginMonth(int year, int month)
+{
+    const QDate m(year, month, 1);
+    if (m != m_month) {
+        // 換月：在基準回來前先歸零，差額從頭累計
+        m_month = m;
+        m_income = 0;
+        m_expense = 0;
+        m_level = 0;
+    }
+    m_pendingIncome = 0;
+    m_pendingExpense = 0;
+}
+
+void BudgetTracker::setBaseline(int year, int month, double income, double expense)
+{
+    if (QDate(year, month, 1) != m_month) return;   // 已經換到別的月了
+
+    m_income = income + m_pendingIncome;
+    m_expense = expense + m_pendingExpense;
+    m_pendingIncome = 0;
+    m_pendingExpense = 0;
+
+    // 只是看這個月，不算「跨過」
+    update(false);
+}
+
+void BudgetTracker::setProvisional(int year, int month, double income, double expense)
+{
+    if (QDate(year, month, 1) != m_month) return;
+
+    m_income = income + m_pendingIncome;
+    m_expense = expense + m_pendingExpense;
+    update(false);
+}
+
+void BudgetTracker::addDelta(const QDate &date, double incomeDelta, double expenseDelta)
+{
+    if (QDate(date.year(), date.month(), 1) != m_month) return;
+
+    m_income += incomeDelta;
+    m_expense += expenseDelta;
+    m_pendingIncome += incomeDelta;
+    m_pendingExpense += expenseDelta;
+    update(true);
+}
+
+double BudgetTracker::usedPercent() const
+{
+    return m_budget > 0 ? m_expense * 100.0 / m_budget : 0.0;
+}
+
+int BudgetTracker::levelFor(double expense) const
+{
+    if (m_budget <= 0) return 0;
+
+    const double pct = expense * 100.0 / m_budget;
+    int level = 0;
+    for (int t : m_thresholds)
+        if (pct >= t) level++;
+    return level;
+}
+
+// 預算門檻檢查
+void BudgetTracker::update(bool notify)
+{
+    TRACE_SCOPE("BudgetTracker::update");
+    const int level = levelFor(m_expense);
+    const int old = m_level;
+    m_level = level;   // 往下掉也記下來，之後再跨上去會再提醒
+
+    emit totalsChanged();
+
+    if (notify && level > old)
+        emit thresholdCrossed(m_thresholds[level - 1], m_expense, m_budget);
+}
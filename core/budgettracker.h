@@ -0,0 +1,54 @@
+#pragma once
+#include <QObject>
+#include <QDate>
+#include <QVector>
+
+// ✅ 本月累計收支：月摘要給基準，之後每次新增 / 修改 / 刪除只加減差額（O(1)）
+// 支出跨過門檻（預設 50/80/100%）往上時才發 thresholdCrossed，停在門檻之上再存檔不會重複提醒
+class BudgetTracker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit BudgetTracker(QObject *parent = nullptr);
+
+    void setThresholds(const QVector<int> &percents);
+    QVector<int> thresholds() const { return m_thresholds; }
+
+    // notify：使用者自己改預算時為 true，改完若跨過門檻也要提醒；換天載入時為 false
+    void setBudget(double budget, bool notify = false);
+
+    // 要求某月的統計時呼叫：從這一刻起的差額要疊到之後回來的基準上
+    void beginMonth(int year, int month);
+    void setBaseline(int year, int month, double income, double expense);
+    // 暖啟動：先顯示快照的數字；差額留著，真正的基準回來再蓋過
+    void setProvisional(int year, int month, double income, double expense);
+
+    // 只算目前追蹤中的月份，其他月份忽略
+    void addDelta(const QDate &date, double incomeDelta, double expenseDelta);
+
+    QDate month() const { return m_month; }
+    double income() const { return m_income; }
+    double expense() const { return m_expense; }
+    double budget() const { return m_budget; }
+    double usedPercent() const;
+
+signals:
+    void totalsChanged();
+    void thresholdCrossed(int percent, double expense, double budget);
+
+private:
+    int levelFor(double expense) const;    // 已達到第幾個門檻（0 = 都沒到）
+    void update(bool notify);
+
+    QVector<int> m_thresholds;
+    QDate m_month;
+    double m_income = 0;
+    double m_expense = 0;
+    double m_budget = 0;
+
+    // beginMonth 之後、基準回來之前的差額
+    double m_pendingIncome = 0;
+    double m_pendingExpense = 0;
+
+    int m_level = 0;
+};
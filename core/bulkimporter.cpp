@@ -0,0 +1,332 @@
+#include "bulkimporter.h"
+#include "todostore.h"
+#include "journal.h"
+#include "todointervals.h"
+
+namespace {
+
+// 每讀這麼多列才看一次時間，回報進度的成本可忽略
+constexpr int kProgressCheckRows = 4096;
+constexpr qint64 kProgressIntervalMs = 250;
+
+QDate parseDate(const QString &s)
+{
+    // 去掉時間部分：2026-01-06 10:00 / 2026-01-06T10:00:00
+    QString d = s.trimmed();
+    for (int i = 0; i < d.size(); ++i) {
+        if (d[i] == ' ' || d[i] == 'T') {
+            d.truncate(i);
+            break;
+        }
+    }
+
+    static const char *formats[] = { "yyyy-MM-dd", "yyyy/MM/dd", "yyyyMMdd", "yyyy/M/d", "yyyy-M-d", "yyyy.MM.dd" };
+    for (const char *f : formats) {
+        QDate date = QDate::fromString(d, QLatin1String(f));
+        if (date.isValid()) return date;
+    }
+    return QDate();
+}
+
+// "1,234" / "NT$1,234" / "(1,234)" / "-1234.50"
+bool parseAmount(const QString &s, double &value)
+{
+    QString t;
+    bool negative = false;
+    for (QChar c : s) {
+        if (c.isDigit() || c == '.') t.append(c);
+        else if (c == '-' || c == '(') negative = true;
+    }
+    if (t.isEmpty()) return false;
+
+    bool ok = false;
+    value = t.toDouble(&ok);
+    if (negative) value = -value;
+    return ok;
+}
+
+int findColumn(const QStringList &header, std::initializer_list<const char *> names)
+{
+    for (int i = 0; i < header.size(); ++i) {
+        const QString h = header[i].trimmed().toLower();
+        for (const char *n : names)
+            if (h == QString::fromUtf8(n)) return i;
+    }
+    return -1;
+}
+
+}
+
+BulkImporter::BulkImporter(int maxBufferedRows)
+    : m_maxBuffered(qMax(1, maxBufferedRows))
+{
+}
+
+bool BulkImporter::parseLegacyTodo(const QString &line, Todo &td, bool &done)
+{
+    // |title|start|end|done
+    const QStringList f = line.split('|');
+    if (f.size() < 5 || !f[0].trimmed().isEmpty()) return false;
+
+    td.title = f[1].trimmed();
+    td.start = QDateTime::fromString(f[2].trimmed(), Qt::ISODate);
+    td.end = QDateTime::fromString(f[3].trimmed(), Qt::ISODate);
+    td.allDay = false;
+    done = f[4].trimmed() == "1";
+
+    return !td.title.isEmpty() && td.start.isValid() && td.end.isValid();
+}
+
+// ✅ 單行 CSV：支援引號欄位與 "" 跳脫（不支援欄位內換行）
+QStringList BulkImporter::splitCsvLine(const QString &line)
+{
+    QStringList out;
+    QString cur;
+    bool quoted = false;
+
+    for (int i = 0; i < line.size(); ++i) {
+        const QChar c = line[i];
+        if (quoted) {
+            if (c == '"') {
+                if (i + 1 < line.size() && line[i + 1] == '"') {
+                    cur.append('"');
+                    ++i;
+                } else {
+                    quoted = false;
+                }
+            } else {
+                cur.append(c);
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            out.append(cur);
+            cur.clear();
+        } else {
+            cur.append(c);
+        }
+    }
+    out.append(cur);
+    return out;
+}
+
+bool BulkImporter::begin(const QString &path)
+{
+    m_stats = ImportStats();
+    m_warnings.clear();
+    m_error.clear();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = QString("%1: %2").arg(path, m_file.errorString());
+        return false;
+    }
+    m_stats.totalBytes = m_file.size();
+    m_timer.start();
+    m_lastReportMs = 0;
+    return true;
+}
+
+bool BulkImporter::readLine(QString &line)
+{
+    if (m_file.atEnd()) return false;
+
+    QByteArray raw = m_file.readLine();
+    m_stats.bytesRead += raw.size();
+
+    // 檔頭的 UTF-8 BOM
+    if (m_stats.bytesRead == raw.size() && raw.startsWith("\xEF\xBB\xBF"))
+        raw.remove(0, 3);
+    while (raw.endsWith('\n') || raw.endsWith('\r'))
+        raw.chop(1);
+
+    line = QString::fromUtf8(raw);
+    return true;
+}
+
+void BulkImporter::warn(const QString &msg, qint64 rows)
+{
+    m_stats.skipped += rows;
+    if (m_warnings.size() < 100)
+        m_warnings.append(msg);
+}
+
+void BulkImporter::reportProgress(bool force)
+{
+    if (!m_progress) return;
+    if (!force && m_stats.rows % kProgressCheckRows != 0) return;
+
+    const qint64 now = m_timer.elapsed();
+    if (!force && now - m_lastReportMs < kProgressIntervalMs) return;
+
+    m_lastReportMs = now;
+    m_stats.elapsedMs = now;
+    m_progress(m_stats);
+}
+
+void BulkImporter::maybeFlush()
+{
+    if (++m_buffered >= m_maxBuffered)
+        flush();
+}
+
+// ✅ 依日期順序寫出：同一天的所有列合併成一次讀檔 + 一次存檔
+void BulkImporter::flush()
+{
+    for (auto it = m_ledger.constBegin(); it != m_ledger.constEnd(); ++it) {
+        m_account.loadFromFile(it.key());
+        for (const AccountItem &item : it.value())
+            m_account.addItem(item);
+
+        if (m_account.saveToFile(it.key())) {
+            m_stats.daysWritten++;
+        } else {
+            m_stats.imported -= it.value().size();
+            warn(QString("write failed: %1").arg(Account::filePath(it.key())), it.value().size());
+        }
+    }
+
+    for (auto it = m_todos.constBegin(); it != m_todos.constEnd(); ++it) {
+        QVector<Todo> todos;
+        QVector<bool> done;
+        TodoStore::load(it.key(), todos, done);
+
+        QVector<QJsonObject> ops;
+        for (int i = 0; i < it->todos.size(); ++i) {
+            todos.append(it->todos[i]);
+            done.append(it->done[i]);
+            ops.append(Journal::opAdd(TodoStore::toJson(it->todos[i], it->done[i])));
+        }
+
+        if (TodoStore::save(it.key(), todos, done, ops)) {
+            m_stats.daysWritten++;
+        } else {
+            m_stats.imported -= ops.size();
+            warn(QString("write failed: %1").arg(TodoStore::filePath(it.key())), ops.size());
+        }
+    }
+
+    m_ledger.clear();
+    m_todos.clear();
+    m_buffered = 0;
+}
+
+void BulkImporter::finish()
+{
+    flush();
+    m_file.close();
+    m_stats.elapsedMs = m_timer.elapsed();
+    reportProgress(true);
+}
+
+bool BulkImporter::importLegacyTodos(const QString &path)
+{
+    if (!begin(path)) return false;
+
+    QString line;
+    while (readLine(line)) {
+        if (line.trimmed().isEmpty()) continue;
+        m_stats.rows++;
+
+        Todo td;
+        bool done = false;
+        if (!parseLegacyTodo(line, td, done)) {
+            warn(QString("row %1: cannot parse \"%2\"").arg(m_stats.rows).arg(line));
+        } else {
+            // 照樣匯入，但提醒時段不合理（不算略過）
+            if (!TodoIntervals::isValidRange(td))
+                warn(QString("row %1: end before start \"%2\"").arg(m_stats.rows).arg(td.title), 0);
+
+            PendingTodos &p = m_todos[td.start.date()];
+            p.todos.append(td);
+            p.done.append(done);
+            m_stats.imported++;
+            maybeFlush();
+        }
+        reportProgress();
+    }
+
+    finish();
+    return true;
+}
+
+// ✅ 銀行對帳單：依表頭找欄位；沒有表頭就當成 日期,金額,摘要
+// 單一金額欄：負數為支出、正數為收入；分成支出/存入兩欄也可以
+bool BulkImporter::importBankCsv(const QString &path)
+{
+    if (!begin(path)) return false;
+
+    int colDate = 0, colAmount = 1, colNote = 2, colDebit = -1, colCredit = -1, colCategory = -1;
+    bool first = true;
+
+    // 對帳單通常依日期排序，同一天連續好幾列：日期字串相同就不必再解析
+    QString lastDateText;
+    QDate lastDate;
+
+    QString line;
+    while (readLine(line)) {
+        if (line.trimmed().isEmpty()) continue;
+        const QStringList f = splitCsvLine(line);
+
+        if (first) {
+            first = false;
+            if (!parseDate(f.value(0)).isValid()) {
+                colDate = findColumn(f, {"date", "transaction date", "posting date", "日期", "交易日期", "記帳日"});
+                colAmount = findColumn(f, {"amount", "金額", "交易金額"});
+                colDebit = findColumn(f, {"debit", "withdrawal", "支出", "提款", "支出金額"});
+                colCredit = findColumn(f, {"credit", "deposit", "存入", "收入", "存入金額"});
+                colNote = findColumn(f, {"description", "memo", "note", "摘要", "說明", "備註"});
+                colCategory = findColumn(f, {"category", "類別"});
+
+                if (colDate < 0 || (colAmount < 0 && colDebit < 0 && colCredit < 0)) {
+                    m_error = QString("%1: header has no date/amount column").arg(path);
+                    m_file.close();
+                    return false;
+                }
+                continue;
+            }
+        }
+
+        m_stats.rows++;
+
+        const QString dateText = f.value(colDate);
+        if (dateText != lastDateText) {
+            lastDateText = dateText;
+            lastDate = parseDate(dateText);
+        }
+        const QDate date = lastDate;
+        double amount = 0;
+        bool ok = false;
+        if (colAmount >= 0) {
+            ok = parseAmount(f.value(colAmount), amount);
+        } else {
+            double debit = 0, credit = 0;
+            const bool hasDebit = parseAmount(f.value(colDebit), debit) && debit != 0;
+            const bool hasCredit = parseAmount(f.value(colCredit), credit) && credit != 0;
+            ok = hasDebit || hasCredit;
+            amount = hasDebit ? -qAbs(debit) : qAbs(credit);
+        }
+
+        if (!date.isValid() || !ok) {
+            warn(QString("row %1: bad date or amount \"%2\"").arg(m_stats.rows).arg(line));
+        } else {
+            AccountItem item;
+            item.date = date;
+            item.amount = qRound(qAbs(amount));
+            item.type = amount < 0 ? EntryType::Expense : EntryType::Income;
+            item.note = colNote >= 0 ? f.value(colNote).trimmed() : QString();
+            const QString cat = colCategory >= 0 ? f.value(colCategory).trimmed() : QString();
+            if (!item.setCategory(cat.isEmpty() ? QStringLiteral("其他") : cat)) {
+                warn(QString("row %1: too many categories, skipped \"%2\"").arg(m_stats.rows).arg(line));
+            } else {
+                m_ledger[date].append(item);
+                m_stats.imported++;
+                maybeFlush();
+            }
+        }
+        reportProgress();
+    }
+
+    finish();
+    return true;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <QDate>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+#include "account.h"
+#include "models.h"
+
+struct ImportStats {
+    qint64 rows = 0;        // 讀到的資料列（不含表頭、空行）
+    qint64 imported = 0;
+    qint64 skipped = 0;
+    qint64 bytesRead = 0;
+    qint64 totalBytes = 0;
+    int daysWritten = 0;
+    qint64 elapsedMs = 0;
+
+    double rowsPerSecond() const { return elapsedMs > 0 ? rows * 1000.0 / elapsedMs : 0.0; }
+};
+
+// ✅ 大量匯入：逐行串流解析，依日期分組，每個受影響的日檔只寫一次
+// 支援舊的 todos.txt（|title|start|end|done）與銀行 CSV 對帳單
+class BulkImporter
+{
+public:
+    using Progress = std::function<void(const ImportStats &)>;
+
+    // maxBufferedRows：緩衝上限，超過就先寫出去，記憶體用量不隨檔案大小成長
+    explicit BulkImporter(int maxBufferedRows = 200000);
+
+    void setProgress(Progress cb) { m_progress = std::move(cb); }
+
+    bool importLegacyTodos(const QString &path);
+    bool importBankCsv(const QString &path);
+
+    const ImportStats& stats() const { return m_stats; }
+    QString errorString() const { return m_error; }
+    // 被略過的資料列（最多保留前 100 筆說明）
+    const QStringList& warnings() const { return m_warnings; }
+
+    static bool parseLegacyTodo(const QString &line, Todo &td, bool &done);
+    static QStringList splitCsvLine(const QString &line);
+
+private:
+    struct PendingTodos {
+        QVector<Todo> todos;
+        QVector<bool> done;
+    };
+
+    bool begin(const QString &path);
+    bool readLine(QString &line);
+    void finish();
+    void warn(const QString &msg, qint64 rows = 1);
+    void reportProgress(bool force = false);
+    void maybeFlush();
+    void flush();
+
+    int m_maxBuffered;
+    int m_buffered = 0;
+    QMap<QDate, QVector<AccountItem>> m_ledger;
+    QMap<QDate, PendingTodos> m_todos;
+
+    Account m_account;      // 依日期順序重複使用：新的一天沿用前一天的月預算（與 app 相同）
+
+    QFile m_file;
+    QElapsedTimer m_timer;
+    qint64 m_lastReportMs = 0;
+
+    ImportStats m_stats;
+    QString m_error;
+    QStringList m_warnings;
+    Progress m_progress;
+};
@@ -0,0 +1,77 @@
+#include "categorytable.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QDebug>
+
+namespace {
+
+struct Table {
+    QReadWriteLock lock;
+    QStringList names;
+    QHash<QString, quint16> ids;
+
+    Table()
+    {
+        for (const QString &n : CategoryTable::builtins()) {
+            ids.insert(n, quint16(names.size()));
+            names.append(n);
+        }
+    }
+};
+
+Table& table()
+{
+    static Table t;
+    return t;
+}
+
+}
+
+const QStringList& CategoryTable::builtins()
+{
+    static const QStringList list = {
+        "飲食","交通","購物","娛樂","日用必需品","醫療","投資","薪水","獎金","零用金","其他"
+    };
+    return list;
+}
+
+quint16 CategoryTable::intern(const QString &name)
+{
+    Table &t = table();
+    {
+        QReadLocker r(&t.lock);
+        auto it = t.ids.constFind(name);
+        if (it != t.ids.constEnd()) return *it;
+    }
+
+    QWriteLocker w(&t.lock);
+    auto it = t.ids.constFind(name);
+    if (it != t.ids.constEnd()) return *it;
+
+    // id 用完：不偷偷改成別的類別，回傳 kInvalid 讓存檔失敗
+    if (t.names.size() >= kInvalid) {
+        qWarning().noquote() << QString("category table full (%1 names), cannot add \"%2\"")
+                                    .arg(t.names.size()).arg(name);
+        return kInvalid;
+    }
+
+    quint16 id = quint16(t.names.size());
+    t.names.append(name);
+    t.ids.insert(name, id);
+    return id;
+}
+
+QString CategoryTable::name(quint16 id)
+{
+    Table &t = table();
+    QReadLocker r(&t.lock);
+    return t.names.value(id);
+}
+
+int CategoryTable::size()
+{
+    Table &t = table();
+    QReadLocker r(&t.lock);
+    return t.names.size();
+}
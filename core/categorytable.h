@@ -0,0 +1,18 @@
+#pragma once
+#include <QString>
+#include <QStringList>
+
+// ✅ 類別字串 → 16-bit id
+// 前 11 個是新增視窗固定提供的類別，id 不變；其他（匯入等）依出現順序往後編
+class CategoryTable
+{
+public:
+    // id 用完時 intern 回傳這個值（name() 為空字串），帶著它的紀錄不能存檔
+    static const quint16 kInvalid = 0xFFFF;
+
+    static const QStringList& builtins();
+
+    static quint16 intern(const QString &name);
+    static QString name(quint16 id);
+    static int size();
+};
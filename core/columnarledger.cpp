@@ -0,0 +1,363 @@
+#include "columnarledger.h"
+#include "account.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QVector>
+#include <algorithm>
+#include <cstring>
+
+// 檔案格式（本機快取，直接用原生位元組序）：
+// Header | DayEntry[days] | qint32 day[rows] | qint32 amount[rows]
+//        | quint16 category[rows] | quint8 kind[rows] | 類別名稱（quint16 長度 + UTF-8）
+// 每段都對齊 8 bytes，map 之後可直接當陣列用
+struct ColumnarLedger::Header {
+    char magic[4];
+    quint32 version;
+    quint32 rows;
+    quint32 days;
+    quint32 categories;
+    quint32 reserved;
+    quint64 offDays;
+    quint64 offDay;
+    quint64 offAmount;
+    quint64 offCategory;
+    quint64 offKind;
+    quint64 offNames;
+};
+
+struct ColumnarLedger::DayEntry {
+    qint32 jd;          // QDate::toJulianDay()
+    quint32 rowBegin;
+    quint32 rowCount;
+    quint32 reserved;
+    qint64 mtime;       // 來源日檔修改時間（ms）
+};
+
+static const char kMagic[4] = {'C', 'L', 'C', '1'};
+static const quint32 kVersion = 1;
+
+enum : quint8 { KindIncome = 1, KindExpense = 2 };
+
+static quint64 align8(quint64 v)
+{
+    return (v + 7) & ~quint64(7);
+}
+
+ColumnarLedger& ColumnarLedger::instance()
+{
+    static ColumnarLedger ledger;
+    return ledger;
+}
+
+ColumnarLedger::ColumnarLedger()
+    : m_path("data/ledger.col")
+{
+}
+
+ColumnarLedger::~ColumnarLedger()
+{
+    close();
+}
+
+const ColumnarLedger::Header* ColumnarLedger::header() const
+{
+    return m_map ? reinterpret_cast<const Header*>(m_map) : nullptr;
+}
+
+const ColumnarLedger::DayEntry* ColumnarLedger::dayTable() const
+{
+    return m_map ? reinterpret_cast<const DayEntry*>(m_map + header()->offDays) : nullptr;
+}
+
+int ColumnarLedger::rowCount() const
+{
+    return m_map ? int(header()->rows) : 0;
+}
+
+int ColumnarLedger::dayCount() const
+{
+    return m_map ? int(header()->days) : 0;
+}
+
+bool ColumnarLedger::open()
+{
+    close();
+
+    m_file.setFileName(m_path);
+    if (!m_file.open(QIODevice::ReadOnly)) return false;
+
+    m_size = m_file.size();
+    if (m_size < qint64(sizeof(Header))) { close(); return false; }
+
+    m_map = m_file.map(0, m_size);
+    if (!m_map) { close(); return false; }
+
+    const Header *h = header();
+    const quint64 rows = h->rows;
+    const bool ok = std::memcmp(h->magic, kMagic, 4) == 0
+                    && h->version == kVersion
+                    && h->offDays + quint64(h->days) * sizeof(DayEntry) <= quint64(m_size)
+                    && h->offDay + rows * 4 <= quint64(m_size)
+                    && h->offAmount + rows * 4 <= quint64(m_size)
+                    && h->offCategory + rows * 2 <= quint64(m_size)
+                    && h->offKind + rows <= quint64(m_size)
+                    && h->offNames <= quint64(m_size);
+    if (!ok) { close(); return false; }
+
+    // 類別表
+    quint64 pos = h->offNames;
+    for (quint32 i = 0; i < h->categories; ++i) {
+        quint16 len = 0;
+        if (pos + 2 > quint64(m_size)) { close(); return false; }
+        std::memcpy(&len, m_map + pos, 2);
+        pos += 2;
+        if (pos + len > quint64(m_size)) { close(); return false; }
+        m_categories.append(QString::fromUtf8(reinterpret_cast<const char*>(m_map + pos), len));
+        pos += len;
+    }
+
+    // 日表的列區間、每列的類別 id 都要落在範圍內，壞檔不拿來查
+    const DayEntry *days = dayTable();
+    for (quint32 i = 0; i < h->days; ++i) {
+        if (quint64(days[i].rowBegin) + days[i].rowCount > rows) { close(); return false; }
+    }
+    const quint16 *cat = reinterpret_cast<const quint16*>(m_map + h->offCategory);
+    for (quint64 i = 0; i < rows; ++i) {
+        if (cat[i] >= h->categories) { close(); return false; }
+    }
+    return true;
+}
+
+void ColumnarLedger::close()
+{
+    if (m_map) m_file.unmap(m_map);
+    m_map = nullptr;
+    m_size = 0;
+    m_file.close();
+    m_categories.clear();
+}
+
+bool ColumnarLedger::sync()
+{
+    QDir dir("data");
+    if (!dir.exists()) dir.mkpath(".");
+
+    const QFileInfoList files = dir.entryInfoList(QStringList{"????-??-??.json"}, QDir::Files, QDir::Name);
+
+    if (!isOpen()) open();
+
+    QHash<qint32, const DayEntry*> old;
+    if (isOpen()) {
+        const DayEntry *t = dayTable();
+        for (quint32 i = 0; i < header()->days; ++i)
+            old.insert(t[i].jd, &t[i]);
+    }
+
+    // 先確認有沒有變：日檔數量一樣、每個修改時間也一樣就不用重建
+    bool changed = !isOpen() || files.size() != old.size();
+    for (int i = 0; i < files.size() && !changed; ++i) {
+        QDate date = QDate::fromString(files[i].fileName().left(10), "yyyy-MM-dd");
+        const DayEntry *e = old.value(qint32(date.toJulianDay()), nullptr);
+        if (!e || e->mtime != files[i].lastModified().toMSecsSinceEpoch())
+            changed = true;
+    }
+    if (!changed) return true;
+
+    QVector<qint32> day, amount;
+    QVector<quint16> cat;
+    QVector<quint8> kind;
+    QVector<DayEntry> days;
+
+    QStringList names;
+    QHash<QString, quint16> ids;
+    auto idOf = [&](const QString &c) -> quint16 {
+        auto it = ids.constFind(c);
+        if (it != ids.constEnd()) return *it;
+        quint16 id = quint16(names.size());
+        names.append(c);
+        ids.insert(c, id);
+        return id;
+    };
+
+    const qint32 *oldDay = nullptr, *oldAmount = nullptr;
+    const quint16 *oldCat = nullptr;
+    const quint8 *oldKind = nullptr;
+    if (isOpen()) {
+        const Header *h = header();
+        oldDay    = reinterpret_cast<const qint32*>(m_map + h->offDay);
+        oldAmount = reinterpret_cast<const qint32*>(m_map + h->offAmount);
+        oldCat    = reinterpret_cast<const quint16*>(m_map + h->offCategory);
+        oldKind   = m_map + h->offKind;
+    }
+
+    for (const QFileInfo &fi : files) {
+        QDate date = QDate::fromString(fi.fileName().left(10), "yyyy-MM-dd");
+        if (!date.isValid()) continue;
+
+        DayEntry e;
+        std::memset(&e, 0, sizeof(e));
+        e.jd = qint32(date.toJulianDay());
+        e.rowBegin = quint32(day.size());
+        e.mtime = fi.lastModified().toMSecsSinceEpoch();
+
+        const DayEntry *prev = old.value(e.jd, nullptr);
+        if (prev && prev->mtime == e.mtime) {
+            // 沒改過：直接從舊檔複製那幾列
+            for (quint32 r = prev->rowBegin; r < prev->rowBegin + prev->rowCount; ++r) {
+                day.append(oldDay[r]);
+                amount.append(oldAmount[r]);
+                cat.append(idOf(m_categories.value(oldCat[r])));
+                kind.append(oldKind[r]);
+            }
+        } else {
+            QVector<AccountItem> items;
+            bool hasBudget = false;
+            double budget = 0.0;
+            Account::readDayFile(date, items, hasBudget, budget);
+
+            for (const auto &item : items) {
+                day.append(e.jd);
+                amount.append(item.amount);
+                cat.append(idOf(item.category()));
+                kind.append(item.type == EntryType::Income  ? KindIncome
+                            : item.type == EntryType::Expense ? KindExpense : 0);
+            }
+        }
+
+        e.rowCount = quint32(day.size()) - e.rowBegin;
+        days.append(e);
+    }
+
+    const quint64 rows = quint64(day.size());
+
+    Header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kMagic, 4);
+    h.version = kVersion;
+    h.rows = quint32(rows);
+    h.days = quint32(days.size());
+    h.categories = quint32(names.size());
+
+    quint64 off = align8(sizeof(Header));
+    h.offDays     = off; off = align8(off + sizeof(DayEntry) * quint64(days.size()));
+    h.offDay      = off; off = align8(off + rows * 4);
+    h.offAmount   = off; off = align8(off + rows * 4);
+    h.offCategory = off; off = align8(off + rows * 2);
+    h.offKind     = off; off = align8(off + rows);
+    h.offNames    = off;
+
+    QByteArray namesBlob;
+    for (const QString &n : names) {
+        QByteArray u = n.toUtf8();
+        quint16 len = quint16(u.size());
+        namesBlob.append(reinterpret_cast<const char*>(&len), 2);
+        namesBlob.append(u);
+    }
+
+    // 舊 map 的資料都複製完了，先放掉再寫新檔
+    close();
+
+    QSaveFile out(m_path);
+    if (!out.open(QIODevice::WriteOnly)) return false;
+
+    quint64 pos = 0;
+    auto writeAt = [&](quint64 at, const void *p, quint64 n) {
+        if (at > pos) out.write(QByteArray(int(at - pos), '\0'));
+        out.write(reinterpret_cast<const char*>(p), qint64(n));
+        pos = at + n;
+    };
+
+    writeAt(0, &h, sizeof(h));
+    writeAt(h.offDays, days.constData(), sizeof(DayEntry) * quint64(days.size()));
+    writeAt(h.offDay, day.constData(), rows * 4);
+    writeAt(h.offAmount, amount.constData(), rows * 4);
+    writeAt(h.offCategory, cat.constData(), rows * 2);
+    writeAt(h.offKind, kind.constData(), rows);
+    writeAt(h.offNames, namesBlob.constData(), quint64(namesBlob.size()));
+
+    if (!out.commit()) return false;
+    return open();
+}
+
+void ColumnarLedger::rowRange(const QDate &from, const QDate &to, int &begin, int &end) const
+{
+    begin = end = 0;
+    if (!m_map || !from.isValid() || !to.isValid() || to < from) return;
+
+    const DayEntry *t = dayTable();
+    const DayEntry *last = t + header()->days;
+
+    const qint32 lo = qint32(from.toJulianDay());
+    const qint32 hi = qint32(to.toJulianDay());
+
+    const DayEntry *a = std::lower_bound(t, last, lo,
+                                         [](const DayEntry &e, qint32 jd){ return e.jd < jd; });
+    const DayEntry *b = std::upper_bound(a, last, hi,
+                                         [](qint32 jd, const DayEntry &e){ return jd < e.jd; });
+
+    begin = (a == last) ? int(header()->rows) : int(a->rowBegin);
+    end   = (b == last) ? int(header()->rows) : int(b->rowBegin);
+}
+
+// ✅ 收支加總：沒有分支的迴圈，編譯器可以向量化
+ColumnarTotals ColumnarLedger::sum(const QDate &from, const QDate &to) const
+{
+    ColumnarTotals out;
+
+    int b = 0, e = 0;
+    rowRange(from, to, b, e);
+    if (b >= e) return out;
+
+    const Header *h = header();
+    const qint32 *amount = reinterpret_cast<const qint32*>(m_map + h->offAmount);
+    const quint8 *kind = m_map + h->offKind;
+
+    qint64 inc = 0, exp = 0;
+    for (int i = b; i < e; ++i) {
+        const qint64 a = amount[i];
+        inc += a * (kind[i] & 1);
+        exp += a * ((kind[i] >> 1) & 1);
+    }
+
+    out.income = inc;
+    out.expense = exp;
+    out.count = e - b;
+    return out;
+}
+
+QHash<QString, CategoryTotal> ColumnarLedger::byCategory(const QDate &from, const QDate &to) const
+{
+    QHash<QString, CategoryTotal> out;
+
+    int b = 0, e = 0;
+    rowRange(from, to, b, e);
+    if (b >= e) return out;
+
+    const Header *h = header();
+    const qint32 *amount = reinterpret_cast<const qint32*>(m_map + h->offAmount);
+    const quint16 *cat = reinterpret_cast<const quint16*>(m_map + h->offCategory);
+    const quint8 *kind = m_map + h->offKind;
+
+    const int n = m_categories.size();
+    QVector<qint64> inc(n, 0), exp(n, 0);
+    QVector<int> cnt(n, 0);
+
+    for (int i = b; i < e; ++i) {
+        const quint16 c = cat[i];
+        const qint64 a = amount[i];
+        inc[c] += a * (kind[i] & 1);
+        exp[c] += a * ((kind[i] >> 1) & 1);
+        cnt[c]++;
+    }
+
+    for (int c = 0; c < n; ++c) {
+        if (cnt[c] == 0) continue;
+        CategoryTotal &t = out[m_categories[c]];
+        t.income = double(inc[c]);
+        t.expense = double(exp[c]);
+        t.count = cnt[c];
+    }
+    return out;
+}
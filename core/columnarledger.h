@@ -0,0 +1,52 @@
+#pragma once
+#include <QDate>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+#include "monthsummary.h"
+
+struct ColumnarTotals {
+    qint64 income = 0;
+    qint64 expense = 0;
+    int count = 0;
+};
+
+// ✅ 唯讀欄式帳本：data/ledger.col
+// 由 data/*.json 產生，日期 / 金額 / 類別 id / 收支旗標各自一段連續陣列，
+// 以 QFile::map 開啟，區間加總就是對陣列的一個緊密迴圈
+class ColumnarLedger
+{
+public:
+    static ColumnarLedger& instance();
+
+    ColumnarLedger();
+    ~ColumnarLedger();
+
+    // 列一次資料夾，修改時間不同的日檔才重讀；有變動就重寫並重新 map
+    bool sync();
+
+    bool isOpen() const { return m_map != nullptr; }
+    int rowCount() const;
+    int dayCount() const;
+
+    ColumnarTotals sum(const QDate &from, const QDate &to) const;
+    QHash<QString, CategoryTotal> byCategory(const QDate &from, const QDate &to) const;
+
+private:
+    struct Header;
+    struct DayEntry;
+
+    bool open();
+    void close();
+    const Header* header() const;
+    const DayEntry* dayTable() const;
+    void rowRange(const QDate &from, const QDate &to, int &begin, int &end) const;
+
+    QString m_path;
+    QFile m_file;
+    uchar *m_map = nullptr;
+    qint64 m_size = 0;
+    QStringList m_categories;
+};
@@ -0,0 +1,19 @@
+# ✅ 使用 core 的子專案 include 這個檔
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+CORE_OUT = $$OUT_PWD/../core
+
+win32:CONFIG(release, debug|release): CORE_OUT = $$CORE_OUT/release
+else:win32:CONFIG(debug, debug|release): CORE_OUT = $$CORE_OUT/debug
+
+LIBS += -L$$CORE_OUT -lcalendarcore
+
+win32-g++: PRE_TARGETDEPS += $$CORE_OUT/libcalendarcore.a
+else:win32: PRE_TARGETDEPS += $$CORE_OUT/calendarcore.lib
+else: PRE_TARGETDEPS += $$CORE_OUT/libcalendarcore.a
+
+qtHaveModule(sql) {
+    QT += sql
+    DEFINES += CALENDAR_HAVE_SQLITE
+}
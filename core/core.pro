@@ -0,0 +1,61 @@
+QT = core
+CONFIG += c++17 staticlib
+TEMPLATE = lib
+TARGET = calendarcore
+
+SOURCES += \
+    account.cpp \
+    monthsummary.cpp \
+    daycache.cpp \
+    ledgerquery.cpp \
+    datepresence.cpp \
+    todostore.cpp \
+    journal.cpp \
+    columnarledger.cpp \
+    storageservice.cpp \
+    writebehind.cpp \
+    categorytable.cpp \
+    bulkimporter.cpp \
+    dailytotals.cpp \
+    balanceindex.cpp \
+    budgettracker.cpp \
+    searchindex.cpp \
+    recurrence.cpp \
+    todointervals.cpp \
+    daystore.cpp \
+    edithistory.cpp \
+    startupsnapshot.cpp \
+    trace.cpp
+
+HEADERS += \
+    account.h \
+    monthsummary.h \
+    daycache.h \
+    ledgerquery.h \
+    datepresence.h \
+    todostore.h \
+    journal.h \
+    columnarledger.h \
+    storageservice.h \
+    writebehind.h \
+    categorytable.h \
+    bulkimporter.h \
+    dailytotals.h \
+    balanceindex.h \
+    budgettracker.h \
+    searchindex.h \
+    recurrence.h \
+    todointervals.h \
+    daystore.h \
+    edithistory.h \
+    startupsnapshot.h \
+    trace.h \
+    models.h
+
+# ✅ 有 QtSql 才編 sqlite 後端（CALENDAR_STORAGE=sqlite）
+qtHaveModule(sql) {
+    QT += sql
+    DEFINES += CALENDAR_HAVE_SQLITE
+    SOURCES += sqlitedaystore.cpp
+    HEADERS += sqlitedaystore.h
+}
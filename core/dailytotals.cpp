@@ -0,0 +1,97 @@
+#include "dailytotals.h"
+#include "daystore.h"
+#include "monthsummary.h"
+#include "recurrence.h"
+
+#include <QtMath>
+
+DailyTotals::DailyTotals(int year)
+    : m_year(year),
+      m_expense(366, 0.0f),
+      m_income(366, 0.0f)
+{
+}
+
+DailyTotals DailyTotals::load(int year)
+{
+    DailyTotals t(year);
+    QMap<QDate, DayTotal> days;
+    const DayStore &store = DayStore::instance();
+    if (store.indexed()) {
+        days = store.dayTotals(QDate(year, 1, 1), QDate(year, 12, 31));
+    } else {
+        for (int m = 1; m <= 12; ++m) {
+            const MonthSummary s = MonthSummary::load(year, m);
+            for (auto it = s.days().constBegin(); it != s.days().constEnd(); ++it)
+                days.insert(QDate(year, m, it.key()), it.value());
+        }
+    }
+    for (auto it = days.constBegin(); it != days.constEnd(); ++it) {
+        const int i = t.index(it.key());
+        if (i < 0) continue;
+        t.m_expense[i] = float(it->expense);
+        t.m_income[i] = float(it->income);
+    }
+
+    // 週期規則展開的收支疊在日檔之上
+    const auto recurring = RecurrenceStore::instance().ledgerTotals(QDate(year, 1, 1), QDate(year, 12, 31));
+    for (auto it = recurring.constBegin(); it != recurring.constEnd(); ++it) {
+        const int i = t.index(it.key());
+        if (i < 0) continue;
+        t.m_expense[i] += float(it->expense);
+        t.m_income[i] += float(it->income);
+    }
+    t.recomputeMax();
+    return t;
+}
+
+int DailyTotals::index(const QDate &date) const
+{
+    if (!date.isValid() || date.year() != m_year) return -1;
+    return date.dayOfYear() - 1;
+}
+
+double DailyTotals::expense(const QDate &date) const
+{
+    const int i = index(date);
+    return i < 0 ? 0.0 : m_expense[i];
+}
+
+double DailyTotals::income(const QDate &date) const
+{
+    const int i = index(date);
+    return i < 0 ? 0.0 : m_income[i];
+}
+
+int DailyTotals::level(const QDate &date, int levels) const
+{
+    const double e = expense(date);
+    if (e <= 0 || m_maxExpense <= 0) return 0;
+
+    const int l = int(std::ceil(std::sqrt(e / m_maxExpense) * levels));
+    return qBound(1, l, levels);
+}
+
+bool DailyTotals::setDay(const QDate &date, double income, double expense)
+{
+    const int i = index(date);
+    if (i < 0) return false;
+
+    const double old = m_expense[i];
+    m_expense[i] = float(expense);
+    m_income[i] = float(income);
+
+    const double before = m_maxExpense;
+    if (expense > m_maxExpense)
+        m_maxExpense = expense;
+    else if (old >= m_maxExpense)
+        recomputeMax();   // 原本的最大值變小了
+    return !qFuzzyCompare(before + 1, m_maxExpense + 1);
+}
+
+void DailyTotals::recomputeMax()
+{
+    m_maxExpense = 0;
+    for (float e : m_expense)
+        m_maxExpense = qMax(m_maxExpense, double(e));
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <QDate>
+#include <QVector>
+
+// ✅ 每日收支索引：一年一組陣列（index = dayOfYear - 1），由 12 份月摘要建成
+// 熱度圖與年度總覽畫格子時只查表，不碰日檔
+class DailyTotals
+{
+public:
+    DailyTotals() = default;
+    explicit DailyTotals(int year);
+
+    // 讀當年 12 份月摘要（缺的會由 MonthSummary 自己重建）
+    static DailyTotals load(int year);
+
+    int year() const { return m_year; }
+    bool isValid() const { return m_year != 0; }
+
+    double expense(const QDate &date) const;
+    double income(const QDate &date) const;
+    double maxExpense() const { return m_maxExpense; }
+
+    // 0 = 沒支出，1..levels 依當年最大單日支出分級（平方根刻度，小額也看得出差異）
+    int level(const QDate &date, int levels) const;
+
+    // 存檔後直接更新那一天，不必重讀摘要；回傳分級基準（最大值）是否改變
+    bool setDay(const QDate &date, double income, double expense);
+
+private:
+    int index(const QDate &date) const;
+    void recomputeMax();
+
+    int m_year = 0;
+    QVector<float> m_expense;   // float 就夠：一年約 1.5KB
+    QVector<float> m_income;
+    double m_maxExpense = 0;
+};
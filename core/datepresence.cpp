@@ -0,0 +1,136 @@
+#include "datepresence.h"
+#include "daycache.h"
+#include "daystore.h"
+#include "journal.h"
+
+#include <QDir>
+
+DatePresence::DatePresence(const QString &dir, QObject *parent, bool scanNow)
+    : QObject(parent), m_dir(dir)
+{
+    QDir d(m_dir);
+    if (!d.exists()) d.mkpath(".");
+
+    // 一次存很多檔時 directoryChanged 會連發，合併成一次重掃
+    m_rescanTimer.setSingleShot(true);
+    m_rescanTimer.setInterval(100);
+    connect(&m_rescanTimer, &QTimer::timeout, this, &DatePresence::rescan);
+
+    m_watcher.addPath(m_dir);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, [=]{
+        m_rescanTimer.start();
+    });
+
+    if (scanNow) rescan();
+}
+
+bool DatePresence::testBit(const QHash<int, QBitArray> &map, const QDate &date)
+{
+    auto it = map.constFind(date.year());
+    if (it == map.constEnd()) return false;
+    return it->testBit(date.dayOfYear() - 1);
+}
+
+bool DatePresence::setBit(QHash<int, QBitArray> &map, const QDate &date)
+{
+    QBitArray &bits = map[date.year()];
+    if (bits.isEmpty()) bits.resize(366);
+
+    int i = date.dayOfYear() - 1;
+    if (bits.testBit(i)) return false;
+    bits.setBit(i);
+    return true;
+}
+
+bool DatePresence::hasLedger(const QDate &date) const
+{
+    return testBit(m_ledger, date);
+}
+
+bool DatePresence::hasTodo(const QDate &date) const
+{
+    return testBit(m_todo, date);
+}
+
+int DatePresence::firstLedgerYear() const
+{
+    int first = 0;
+    for (auto it = m_ledger.constBegin(); it != m_ledger.constEnd(); ++it)
+        if (first == 0 || it.key() < first) first = it.key();
+    return first;
+}
+
+QSet<QDate> DatePresence::marksForMonth(int year, int month) const
+{
+    QSet<QDate> marks;
+    QDate first(year, month, 1);
+    int days = first.daysInMonth();
+
+    for (int d = 1; d <= days; ++d) {
+        QDate date(year, month, d);
+        if (contains(date))
+            marks.insert(date);
+    }
+    return marks;
+}
+
+void DatePresence::markLedger(const QDate &date)
+{
+    if (setBit(m_ledger, date))
+        emit changed();
+}
+
+void DatePresence::markTodo(const QDate &date)
+{
+    if (setBit(m_todo, date))
+        emit changed();
+}
+
+// ✅ 只列一次資料夾，不逐日 stat
+void DatePresence::rescan()
+{
+    QHash<int, QBitArray> ledger;
+    QHash<int, QBitArray> todo;
+
+    // 有索引的後端：直接問資料庫哪些天有資料
+    const DayStore &store = DayStore::instance();
+    if (store.indexed()) {
+        for (const QDate &date : store.days(DayStore::Ledger)) {
+            setBit(ledger, date);
+            if (!testBit(m_ledger, date)) DayCache::instance().invalidate(date);
+        }
+        for (const QDate &date : store.days(DayStore::Todos)) {
+            setBit(todo, date);
+            if (!testBit(m_todo, date)) DayCache::instance().invalidate(date);
+        }
+    } else {
+        const QStringList names = QDir(m_dir).entryList(
+            QStringList{"????-??-??.json", "????-??-??.todo.json"}, QDir::Files);
+
+        for (const QString &name : names) {
+            QDate date = QDate::fromString(name.left(10), "yyyy-MM-dd");
+            if (!date.isValid()) continue;
+
+            bool isTodo = name.endsWith(".todo.json");
+            setBit(isTodo ? todo : ledger, date);
+        }
+
+        // 外部新增、修改或刪掉的日檔（例如 calendar-cli import）：快取裡那天的舊內容作廢
+        const QVector<QDate> stale = DayCache::instance().invalidateChanged();
+        if (!stale.isEmpty()) emit daysChangedOnDisk(stale);
+
+        // journal 裡還沒壓回日檔的日子也要有白點
+        if (Journal::enabled()) {
+            const Journal &journal = Journal::instance();
+            for (const QDate &date : journal.pendingDates("ledger")) setBit(ledger, date);
+            for (const QDate &date : journal.pendingDates("todo")) setBit(todo, date);
+        }
+    }
+
+    bool same = m_scanned && (ledger == m_ledger && todo == m_todo);
+    m_ledger = ledger;
+    m_todo = todo;
+    m_scanned = true;
+
+    if (!same) emit changed();
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <QObject>
+#include <QBitArray>
+#include <QDate>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QVector>
+
+// ✅ 每年一張 bitmap：哪幾天有記帳檔 / 待辦檔
+// 開始時列一次 data/，之後靠 QFileSystemWatcher 與 app 自己的存檔維持
+class DatePresence : public QObject
+{
+    Q_OBJECT
+public:
+    // scanNow 為 false：先不列資料夾，等呼叫端（第一個畫面之後）自己 rescan
+    explicit DatePresence(const QString &dir = "data", QObject *parent = nullptr, bool scanNow = true);
+
+    bool isScanned() const { return m_scanned; }
+
+    bool hasLedger(const QDate &date) const;
+    bool hasTodo(const QDate &date) const;
+    bool contains(const QDate &date) const { return hasLedger(date) || hasTodo(date); }
+
+    QSet<QDate> marksForMonth(int year, int month) const;
+
+    // 最早有記帳的年份；沒有資料回傳 0
+    int firstLedgerYear() const;
+
+    // 存檔成功後呼叫
+    void markLedger(const QDate &date);
+    void markTodo(const QDate &date);
+
+    void rescan();
+
+signals:
+    void changed();
+    // 快取過的日子在 app 外被改掉 / 刪掉（rescan 發現修改時間不同）
+    void daysChangedOnDisk(const QVector<QDate> &dates);
+
+private:
+    static bool testBit(const QHash<int, QBitArray> &map, const QDate &date);
+    static bool setBit(QHash<int, QBitArray> &map, const QDate &date);
+
+    QString m_dir;
+    QHash<int, QBitArray> m_ledger;
+    QHash<int, QBitArray> m_todo;
+    bool m_scanned = false;
+
+    QFileSystemWatcher m_watcher;
+    QTimer m_rescanTimer;
+};
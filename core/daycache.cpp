@@ -0,0 +1,172 @@
+#include "daycache.h"
+#include "todostore.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+static qint64 fileMtime(const QString &path)
+{
+    const QFileInfo fi(path);
+    return fi.exists() ? fi.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+DayCache& DayCache::instance()
+{
+    static DayCache cache;
+    return cache;
+}
+
+DayCache::DayCache(int capacity)
+    : m_capacity(qMax(1, capacity))
+{
+}
+
+bool DayCache::lookup(const QDate &date, bool DayRecord::*loaded, DayRecord &out)
+{
+    QMutexLocker lock(&m_mutex);
+
+    auto it = m_map.find(date);
+    if (it == m_map.end() || !(it->record.*loaded)) {
+        m_misses++;
+        return false;
+    }
+
+    m_hits++;
+    m_order.splice(m_order.begin(), m_order, it->pos);
+    out = it->record;
+    return true;
+}
+
+bool DayCache::ledger(const QDate &date, DayRecord &out)
+{
+    return lookup(date, &DayRecord::ledgerLoaded, out);
+}
+
+bool DayCache::todos(const QDate &date, DayRecord &out)
+{
+    return lookup(date, &DayRecord::todosLoaded, out);
+}
+
+DayRecord& DayCache::touch(const QDate &date)
+{
+    auto it = m_map.find(date);
+    if (it != m_map.end()) {
+        m_order.splice(m_order.begin(), m_order, it->pos);
+        return it->record;
+    }
+
+    m_order.push_front(date);
+    Node &n = m_map[date];
+    n.pos = m_order.begin();
+    return n.record;
+}
+
+void DayCache::evict()
+{
+    while (m_map.size() > m_capacity && !m_order.empty()) {
+        m_map.remove(m_order.back());
+        m_order.pop_back();
+        m_evictions++;
+    }
+}
+
+void DayCache::putLedger(const QDate &date, bool exists, const QVector<AccountItem> &items,
+                         bool hasBudget, double monthlyBudget)
+{
+    QMutexLocker lock(&m_mutex);
+    DayRecord &r = touch(date);
+    r.ledgerLoaded = true;
+    r.ledgerExists = exists;
+    r.ledgerMtime = fileMtime(Account::filePath(date));
+    r.items = items;
+    r.hasBudget = hasBudget;
+    r.monthlyBudget = monthlyBudget;
+    evict();
+}
+
+void DayCache::putTodos(const QDate &date, bool exists, const QVector<Todo> &todos,
+                        const QVector<bool> &done)
+{
+    QMutexLocker lock(&m_mutex);
+    DayRecord &r = touch(date);
+    r.todosLoaded = true;
+    r.todosExists = exists;
+    r.todosMtime = fileMtime(TodoStore::filePath(date));
+    r.todos = todos;
+    r.todoDone = done;
+    evict();
+}
+
+void DayCache::invalidate(const QDate &date)
+{
+    QMutexLocker lock(&m_mutex);
+    auto it = m_map.find(date);
+    if (it == m_map.end()) return;
+    m_order.erase(it->pos);
+    m_map.erase(it);
+}
+
+QVector<QDate> DayCache::invalidateChanged()
+{
+    QMutexLocker lock(&m_mutex);
+
+    QVector<QDate> dropped;
+    for (auto it = m_map.begin(); it != m_map.end(); ) {
+        const DayRecord &r = it->record;
+        const bool stale = (r.ledgerLoaded && fileMtime(Account::filePath(it.key())) != r.ledgerMtime)
+                           || (r.todosLoaded && fileMtime(TodoStore::filePath(it.key())) != r.todosMtime);
+        if (stale) {
+            dropped.append(it.key());
+            m_order.erase(it->pos);
+            it = m_map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return dropped;
+}
+
+void DayCache::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    m_map.clear();
+    m_order.clear();
+}
+
+void DayCache::setCapacity(int capacity)
+{
+    QMutexLocker lock(&m_mutex);
+    m_capacity = qMax(1, capacity);
+    evict();
+}
+
+int DayCache::capacity() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_capacity;
+}
+
+int DayCache::size() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_map.size();
+}
+
+quint64 DayCache::hits() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_hits;
+}
+
+quint64 DayCache::misses() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_misses;
+}
+
+quint64 DayCache::evictions() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_evictions;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <QDate>
+#include <QHash>
+#include <QVector>
+#include <QMutex>
+#include <list>
+
+#include "account.h"
+#include "models.h"
+
+// ✅ 一天的解析結果（記帳 + 待辦），兩邊各自記錄是否已從磁碟讀過
+struct DayRecord {
+    bool ledgerLoaded = false;
+    bool ledgerExists = false;
+    qint64 ledgerMtime = -1;    // 放進快取時日檔的修改時間（ms，沒有檔案為 -1）
+    QVector<AccountItem> items;
+    bool hasBudget = false;
+    double monthlyBudget = 0.0;
+
+    bool todosLoaded = false;
+    bool todosExists = false;
+    qint64 todosMtime = -1;
+    QVector<Todo> todos;
+    QVector<bool> todoDone;
+};
+
+// ✅ 依 QDate 的 LRU 快取，記帳與待辦的讀檔共用
+// 存取都有鎖：儲存執行緒與 GUI（DatePresence 作廢）都會用到
+class DayCache
+{
+public:
+    static DayCache& instance();
+
+    explicit DayCache(int capacity = 64);
+
+    // 該部分已快取就移到最前面、複製到 out 並回傳 true；否則算一次 miss
+    bool ledger(const QDate &date, DayRecord &out);
+    bool todos(const QDate &date, DayRecord &out);
+
+    void putLedger(const QDate &date, bool exists, const QVector<AccountItem> &items,
+                   bool hasBudget, double monthlyBudget);
+    void putTodos(const QDate &date, bool exists, const QVector<Todo> &todos,
+                  const QVector<bool> &done);
+
+    void invalidate(const QDate &date);
+    // 資料夾有變動時呼叫：日檔修改時間和放進快取時不同（被外部改掉、刪掉或新出現）的日子作廢
+    // 最多 capacity 天，各 stat 一兩次；回傳作廢的日子
+    QVector<QDate> invalidateChanged();
+    void clear();
+
+    void setCapacity(int capacity);
+    int capacity() const;
+    int size() const;
+
+    quint64 hits() const;
+    quint64 misses() const;
+    quint64 evictions() const;
+
+private:
+    struct Node {
+        DayRecord record;
+        std::list<QDate>::iterator pos;
+    };
+
+    bool lookup(const QDate &date, bool DayRecord::*loaded, DayRecord &out);
+    DayRecord& touch(const QDate &date);
+    void evict();
+
+    mutable QMutex m_mutex;
+    int m_capacity;
+    std::list<QDate> m_order;   // 前面 = 最近用過
+    QHash<QDate, Node> m_map;
+
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+    quint64 m_evictions = 0;
+};
@@ -0,0 +1,137 @@
+#include "daystore.h"
+#include "journal.h"
+#include "todostore.h"
+
+#ifdef CALENDAR_HAVE_SQLITE
+#include "sqlitedaystore.h"
+#endif
+
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QDebug>
+#include <algorithm>
+
+DayStore& DayStore::instance()
+{
+#ifdef CALENDAR_HAVE_SQLITE
+    static const bool sqlite = (qgetenv("CALENDAR_STORAGE") == "sqlite");
+    if (sqlite) {
+        static SqliteDayStore db("data/calendar.db");
+        return db;
+    }
+#else
+    // 只判斷一次，不要每次呼叫都讀環境變數、印警告
+    static const bool warned = [] {
+        const bool sqlite = (qgetenv("CALENDAR_STORAGE") == "sqlite");
+        if (sqlite) qWarning() << "storage: built without QtSql, using JSON files";
+        return sqlite;
+    }();
+    Q_UNUSED(warned);
+#endif
+    static JsonDayStore json;
+    return json;
+}
+
+// ===== JsonDayStore =====
+
+QString JsonDayStore::name() const
+{
+    return Journal::enabled() ? "json+journal" : "json";
+}
+
+bool JsonDayStore::loadLedger(const QDate &date, QVector<AccountItem> &items, bool &hasBudget, double &budget)
+{
+    return Journal::enabled()
+               ? Journal::instance().loadLedger(date, items, hasBudget, budget)
+               : Account::readDayFile(date, items, hasBudget, budget);
+}
+
+bool JsonDayStore::saveLedger(const QDate &date, const QVector<AccountItem> &items, double budget,
+                              const QVector<QJsonObject> &ops)
+{
+    // ✅ journal 模式：只追加這次的異動，不重寫整個日檔
+    if (Journal::enabled()) {
+        // 跟整檔寫入一樣，每次存檔都帶上目前的月預算
+        QVector<QJsonObject> withBudget = ops;
+        if (!withBudget.isEmpty() && withBudget.last()["op"].toString() != "budget")
+            withBudget.append(Journal::opBudget(budget));
+        return Journal::instance().append(date, "ledger", withBudget);
+    }
+    return Account::writeDayFile(date, items, budget);
+}
+
+bool JsonDayStore::loadTodos(const QDate &date, QVector<Todo> &todos, QVector<bool> &done)
+{
+    return Journal::enabled()
+               ? Journal::instance().loadTodos(date, todos, done)
+               : TodoStore::readDayFile(date, todos, done);
+}
+
+bool JsonDayStore::saveTodos(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                             const QVector<QJsonObject> &ops)
+{
+    // ✅ journal 模式只追加這次的異動（新增 / 刪除 / 勾選）
+    if (Journal::enabled())
+        return Journal::instance().append(date, "todo", ops);
+    return TodoStore::writeDayFile(date, todos, done);
+}
+
+// ===== 月預算：獨立檔案 =====
+QString JsonDayStore::budgetFilePath(int year, int month)
+{
+    QDir dir("data");
+    if (!dir.exists()) dir.mkpath(".");
+    return QString("data/budget_%1-%2.json")
+        .arg(year)
+        .arg(month, 2, 10, QChar('0'));
+}
+
+bool JsonDayStore::loadMonthBudget(int year, int month, double &budget)
+{
+    QFile f(budgetFilePath(year, month));
+    if (!f.open(QIODevice::ReadOnly)) return false;
+
+    QJsonObject obj = QJsonDocument::fromJson(f.readAll()).object();
+    if (!obj.contains("monthly_budget")) return false;
+
+    budget = obj["monthly_budget"].toDouble();
+    return true;
+}
+
+bool JsonDayStore::saveMonthBudget(int year, int month, double budget)
+{
+    QJsonObject obj;
+    obj["monthly_budget"] = budget;
+
+    QSaveFile f(budgetFilePath(year, month));
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(QJsonDocument(obj).toJson());
+    return f.commit();
+}
+
+// ✅ 只列一次資料夾；journal 裡還沒壓回日檔的日子另外併進來
+QVector<QDate> JsonDayStore::days(Kind kind) const
+{
+    const QString pattern = (kind == Todos) ? "????-??-??.todo.json" : "????-??-??.json";
+    const QStringList names = QDir("data").entryList(QStringList{pattern}, QDir::Files, QDir::Name);
+
+    QVector<QDate> out;
+    out.reserve(names.size());
+    for (const QString &name : names) {
+        const QDate date = QDate::fromString(name.left(10), "yyyy-MM-dd");
+        if (date.isValid()) out.append(date);
+    }
+
+    if (Journal::enabled()) {
+        const QSet<QDate> pending = Journal::instance().pendingDates(kind == Todos ? "todo" : "ledger");
+        const int listed = out.size();
+        for (const QDate &date : pending) {
+            if (!std::binary_search(out.constBegin(), out.constBegin() + listed, date))
+                out.append(date);
+        }
+        if (out.size() > listed) std::sort(out.begin(), out.end());
+    }
+    return out;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <QDate>
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+#include "account.h"
+#include "ledgerquery.h"
+#include "models.h"
+#include "searchindex.h"
+
+// ✅ 記帳 / 待辦的實際存放處：Account、TodoStore 只透過這裡讀寫
+// CALENDAR_STORAGE=sqlite 用 data/calendar.db，其餘（含 journal）是原本的每日 JSON
+// 只負責讀寫本身；日快取、月摘要與各種索引的更新仍在 Account / TodoStore
+class DayStore
+{
+public:
+    enum Kind { Ledger = 0, Todos = 1 };
+
+    static DayStore& instance();
+    virtual ~DayStore() = default;
+
+    virtual QString name() const = 0;
+
+    // 沒資料回傳 false（也算正常）
+    virtual bool loadLedger(const QDate &date, QVector<AccountItem> &items, bool &hasBudget, double &budget) = 0;
+    // ops：上次存檔後的異動（journal 只寫這些）
+    virtual bool saveLedger(const QDate &date, const QVector<AccountItem> &items, double budget,
+                            const QVector<QJsonObject> &ops) = 0;
+    virtual bool loadTodos(const QDate &date, QVector<Todo> &todos, QVector<bool> &done) = 0;
+    virtual bool saveTodos(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                           const QVector<QJsonObject> &ops) = 0;
+
+    virtual bool loadMonthBudget(int year, int month, double &budget) = 0;
+    virtual bool saveMonthBudget(int year, int month, double budget) = 0;
+
+    // 有資料的日子，依日期排序
+    virtual QVector<QDate> days(Kind kind) const = 0;
+
+    // ✅ 有索引的後端：區間統計、每日收支、搜尋各是一個查詢
+    // indexed() 為 false 時呼叫端照舊走月摘要、日檔 bitmap 與搜尋索引
+    virtual bool indexed() const { return false; }
+    virtual RangeTotals aggregate(const QDate &, const QDate &) const { return RangeTotals(); }
+    virtual QMap<QDate, DayTotal> dayTotals(const QDate &, const QDate &) const { return {}; }
+    virtual QVector<SearchHit> search(const QString &, int) const { return {}; }
+};
+
+// ✅ 原本的版面：data/yyyy-MM-dd.json、yyyy-MM-dd.todo.json、budget_yyyy-MM.json
+// journal 模式讀檔時重播日誌、存檔只追加異動
+class JsonDayStore : public DayStore
+{
+public:
+    QString name() const override;
+
+    bool loadLedger(const QDate &date, QVector<AccountItem> &items, bool &hasBudget, double &budget) override;
+    bool saveLedger(const QDate &date, const QVector<AccountItem> &items, double budget,
+                    const QVector<QJsonObject> &ops) override;
+    bool loadTodos(const QDate &date, QVector<Todo> &todos, QVector<bool> &done) override;
+    bool saveTodos(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                   const QVector<QJsonObject> &ops) override;
+
+    bool loadMonthBudget(int year, int month, double &budget) override;
+    bool saveMonthBudget(int year, int month, double budget) override;
+
+    QVector<QDate> days(Kind kind) const override;
+
+    static QString budgetFilePath(int year, int month);
+};
@@ -0,0 +1,135 @@
+#include "edithistory.h"
+
+// ===== EditCommand =====
+
+EditCommand EditCommand::addEntry(const QDate &date, int index, const AccountItem &item)
+{
+    EditCommand c;
+    c.kind = AddEntry;
+    c.date = date;
+    c.index = index;
+    c.entry = item;
+    return c;
+}
+
+EditCommand EditCommand::removeEntry(const QDate &date, int index, const AccountItem &item)
+{
+    EditCommand c = addEntry(date, index, item);
+    c.kind = RemoveEntry;
+    return c;
+}
+
+EditCommand EditCommand::updateEntry(const QDate &date, int index, const AccountItem &before, const AccountItem &after)
+{
+    EditCommand c = addEntry(date, index, after);
+    c.kind = UpdateEntry;
+    c.previous = before;
+    return c;
+}
+
+EditCommand EditCommand::setBudget(const QDate &date, double before, double after)
+{
+    EditCommand c;
+    c.kind = SetBudget;
+    c.date = date;
+    c.budgetBefore = before;
+    c.budgetAfter = after;
+    return c;
+}
+
+EditCommand EditCommand::addTodo(const QDate &date, int index, const Todo &td)
+{
+    EditCommand c;
+    c.kind = AddTodo;
+    c.date = date;
+    c.index = index;
+    c.todo = td;
+    return c;
+}
+
+EditCommand EditCommand::removeTodo(const QDate &date, int index, const Todo &td, bool done)
+{
+    EditCommand c = addTodo(date, index, td);
+    c.kind = RemoveTodo;
+    c.done = done;
+    return c;
+}
+
+EditCommand EditCommand::toggleTodo(const QDate &date, int index, bool done)
+{
+    EditCommand c;
+    c.kind = ToggleTodo;
+    c.date = date;
+    c.index = index;
+    c.done = done;
+    return c;
+}
+
+QString EditCommand::describe() const
+{
+    const QString item = QString("%1 %2").arg(entry.category()).arg(entry.amount);
+    switch (kind) {
+    case AddEntry:    return QString("新增記帳「%1」").arg(item);
+    case RemoveEntry: return QString("刪除記帳「%1」").arg(item);
+    case UpdateEntry: return QString("修改記帳「%1」").arg(item);
+    case SetBudget:   return QString("設定預算 %1").arg(budgetAfter);
+    case AddTodo:     return QString("新增待辦「%1」").arg(todo.title);
+    case RemoveTodo:  return QString("刪除待辦「%1」").arg(todo.title);
+    case ToggleTodo:  return done ? "勾選待辦" : "取消勾選待辦";
+    }
+    return QString();
+}
+
+qint64 EditCommand::footprint() const
+{
+    // 類別是 16-bit id，不佔字串
+    return qint64(sizeof(EditCommand))
+           + (entry.note.size() + previous.note.size() + todo.title.size() + todo.id.size()) * qint64(sizeof(QChar));
+}
+
+// ===== EditHistory =====
+
+EditHistory::EditHistory(int maxSteps, qint64 maxBytes)
+    : m_maxSteps(maxSteps),
+      m_maxBytes(maxBytes)
+{
+}
+
+void EditHistory::push(const EditCommand &cmd)
+{
+    for (const EditCommand &c : m_redo)
+        m_bytes -= c.footprint();
+    m_redo.clear();
+
+    m_undo.push(cmd);
+    m_bytes += cmd.footprint();
+    trim();
+}
+
+void EditHistory::clear()
+{
+    m_undo.clear();
+    m_redo.clear();
+    m_bytes = 0;
+}
+
+void EditHistory::undone()
+{
+    if (m_undo.isEmpty()) return;
+    m_redo.push(m_undo.pop());
+}
+
+void EditHistory::redone()
+{
+    if (m_redo.isEmpty()) return;
+    m_undo.push(m_redo.pop());
+}
+
+// 最舊的在堆疊底部（index 0）
+void EditHistory::trim()
+{
+    while (!m_undo.isEmpty() && (m_undo.size() > m_maxSteps || m_bytes > m_maxBytes)) {
+        m_bytes -= m_undo.first().footprint();
+        m_undo.removeFirst();
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <QDate>
+#include <QStack>
+#include <QString>
+
+#include "account.h"
+#include "models.h"
+
+// ✅ 一步編輯：只記差異（哪天、第幾筆、那一筆本身），不存整天的快照
+struct EditCommand {
+    enum Kind : quint8 {
+        AddEntry,       // entry 加在 index
+        RemoveEntry,    // index 的 entry 被刪掉
+        UpdateEntry,    // index 由 previous 改成 entry
+        SetBudget,      // 月預算 budgetBefore -> budgetAfter
+        AddTodo,        // todo 加在 index
+        RemoveTodo,     // index 的 todo（完成狀態 done）被刪掉
+        ToggleTodo,     // index 的完成狀態改成 done
+    };
+
+    Kind kind = AddEntry;
+    QDate date;
+    int index = -1;
+    bool done = false;
+    double budgetBefore = 0;
+    double budgetAfter = 0;
+    AccountItem entry;
+    AccountItem previous;
+    Todo todo;
+
+    static EditCommand addEntry(const QDate &date, int index, const AccountItem &item);
+    static EditCommand removeEntry(const QDate &date, int index, const AccountItem &item);
+    static EditCommand updateEntry(const QDate &date, int index, const AccountItem &before, const AccountItem &after);
+    static EditCommand setBudget(const QDate &date, double before, double after);
+    static EditCommand addTodo(const QDate &date, int index, const Todo &td);
+    static EditCommand removeTodo(const QDate &date, int index, const Todo &td, bool done);
+    static EditCommand toggleTodo(const QDate &date, int index, bool done);
+
+    // 選單、提示用："刪除記帳「餐飲 120」"
+    QString describe() const;
+    // 大約佔多少記憶體（字串另計長度）
+    qint64 footprint() const;
+};
+
+// ✅ 復原 / 重做：兩個 QStack，步數與總記憶體都有上限，超過就丟最舊的
+// 只管紀錄；實際套用（讀那天、改、存那天）由呼叫端做
+class EditHistory
+{
+public:
+    explicit EditHistory(int maxSteps = 500, qint64 maxBytes = 1 << 20);
+
+    // 新的編輯：清掉重做
+    void push(const EditCommand &cmd);
+    void clear();
+
+    bool canUndo() const { return !m_undo.isEmpty(); }
+    bool canRedo() const { return !m_redo.isEmpty(); }
+    const EditCommand& nextUndo() const { return m_undo.top(); }
+    const EditCommand& nextRedo() const { return m_redo.top(); }
+
+    // 套用成功後呼叫：把那一步移到另一個堆疊
+    void undone();
+    void redone();
+
+    int undoCount() const { return m_undo.size(); }
+    int redoCount() const { return m_redo.size(); }
+    qint64 bytes() const { return m_bytes; }
+
+private:
+    void trim();
+
+    QStack<EditCommand> m_undo;
+    QStack<EditCommand> m_redo;
+    int m_maxSteps;
+    qint64 m_maxBytes;
+    qint64 m_bytes = 0;
+};
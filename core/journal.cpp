@@ -0,0 +1,438 @@
+#include "journal.h"
+#include "todostore.h"
+
+#include <QDir>
+#include <QSet>
+#include <QUuid>
+#include <QJsonDocument>
+#include <QMutexLocker>
+
+static const char *kJournalPath    = "data/journal.log";
+static const char *kCompactingPath = "data/journal.compacting";
+
+// 累積多少筆異動就在背景壓回日檔
+static const int kCompactThreshold = 512;
+
+static QVector<QJsonObject> readLines(const QString &path)
+{
+    QVector<QJsonObject> out;
+
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return out;
+
+    while (!f.atEnd()) {
+        QByteArray line = f.readLine().trimmed();
+        if (line.isEmpty()) continue;
+
+        // 寫到一半當掉的最後一行會解析失敗，直接略過
+        QJsonDocument doc = QJsonDocument::fromJson(line);
+        if (doc.isObject()) out.append(doc.object());
+    }
+    return out;
+}
+
+static QByteArray toLine(const QJsonObject &op)
+{
+    return QJsonDocument(op).toJson(QJsonDocument::Compact) + '\n';
+}
+
+bool Journal::enabled()
+{
+    static const bool on = (qgetenv("CALENDAR_STORAGE") == "journal");
+    return on;
+}
+
+Journal& Journal::instance()
+{
+    static Journal journal;
+    return journal;
+}
+
+Journal::Journal()
+{
+    QDir dir("data");
+    if (!dir.exists()) dir.mkpath(".");
+
+    m_pool.setMaxThreadCount(1);
+
+    loadFromDisk();
+
+    m_file.setFileName(kJournalPath);
+    m_file.open(QIODevice::WriteOnly | QIODevice::Append);
+
+    // 上次沒壓完的先接著壓；否則把上次留下的日誌壓回日檔
+    if (!m_compacting.isEmpty()) {
+        m_compactionRunning = true;
+        m_pool.start([this]{ compactPending(); });
+    } else if (!m_ops.isEmpty()) {
+        compactAsync();
+    }
+}
+
+Journal::~Journal()
+{
+    waitForCompaction();
+    m_file.close();
+}
+
+QJsonObject Journal::opAdd(const QJsonObject &payload)
+{
+    QJsonObject op;
+    op["op"] = "add";
+    op["item"] = payload;
+    return op;
+}
+
+QJsonObject Journal::opUpdate(int index, const QJsonObject &payload)
+{
+    QJsonObject op;
+    op["op"] = "update";
+    op["index"] = index;
+    op["item"] = payload;
+    return op;
+}
+
+QJsonObject Journal::opRemove(int index)
+{
+    QJsonObject op;
+    op["op"] = "remove";
+    op["index"] = index;
+    return op;
+}
+
+QJsonObject Journal::opInsert(int index, const QJsonObject &payload)
+{
+    QJsonObject op;
+    op["op"] = "insert";
+    op["index"] = index;
+    op["item"] = payload;
+    return op;
+}
+
+QJsonObject Journal::opToggle(int index, bool done)
+{
+    QJsonObject op;
+    op["op"] = "toggle";
+    op["index"] = index;
+    op["done"] = done;
+    return op;
+}
+
+QJsonObject Journal::opBudget(double budget)
+{
+    QJsonObject op;
+    op["op"] = "budget";
+    op["budget"] = budget;
+    return op;
+}
+
+void Journal::loadFromDisk()
+{
+    // journal.compacting：已標記 compacted 的日子已經寫回日檔了
+    // 沒標記的日子，日檔若已帶著同一個批次 id 也不會再套用（見 compactPending）
+    const QVector<QJsonObject> compacting = readLines(kCompactingPath);
+
+    QSet<QString> done;
+    for (const auto &op : compacting) {
+        if (op["op"].toString() == "compacted")
+            done.insert(op["date"].toString());
+        else if (op["op"].toString() == "batch")
+            m_batch = op["id"].toString();
+    }
+
+    for (const auto &op : compacting) {
+        const QString ds = op["date"].toString();
+        const QString type = op["op"].toString();
+        if (type == "compacted" || type == "batch" || done.contains(ds)) continue;
+
+        QDate date = QDate::fromString(ds, Qt::ISODate);
+        if (date.isValid()) m_compacting[date].append(op);
+    }
+
+    if (m_compacting.isEmpty()) {
+        QFile::remove(kCompactingPath);
+        m_batch.clear();
+    }
+
+    for (const auto &op : readLines(kJournalPath)) {
+        QDate date = QDate::fromString(op["date"].toString(), Qt::ISODate);
+        if (!date.isValid()) continue;
+        m_ops[date].append(op);
+        m_count++;
+    }
+}
+
+bool Journal::append(const QDate &date, const QString &kind, const QVector<QJsonObject> &ops)
+{
+    if (ops.isEmpty()) return true;
+
+    QVector<QJsonObject> stamped;
+    QByteArray buf;
+    for (QJsonObject op : ops) {
+        op["date"] = date.toString(Qt::ISODate);
+        op["kind"] = kind;
+        buf += toLine(op);
+        stamped.append(op);
+    }
+
+    bool compact = false;
+    {
+        QMutexLocker lock(&m_mutex);
+        if (!m_file.isOpen()) return false;
+
+        // 不 fsync：一般 write + flush，連續記帳時不會每筆都落盤
+        if (m_file.write(buf) != buf.size()) return false;
+        m_file.flush();
+
+        m_ops[date] += stamped;
+        m_count += stamped.size();
+        compact = (m_count >= kCompactThreshold);
+    }
+
+    if (compact) compactAsync();
+    return true;
+}
+
+void Journal::applyLedger(const QJsonObject &op, const QDate &date,
+                          QVector<AccountItem> &items, bool &hasBudget, double &budget)
+{
+    const QString type = op["op"].toString();
+    const int index = op["index"].toInt(-1);
+
+    if (type == "add") {
+        items.append(Account::itemFromJson(op["item"].toObject(), date));
+    } else if (type == "insert") {
+        if (index >= 0 && index <= items.size())
+            items.insert(index, Account::itemFromJson(op["item"].toObject(), date));
+    } else if (type == "update") {
+        if (index >= 0 && index < items.size())
+            items[index] = Account::itemFromJson(op["item"].toObject(), date);
+    } else if (type == "remove") {
+        if (index >= 0 && index < items.size())
+            items.removeAt(index);
+    } else if (type == "budget") {
+        hasBudget = true;
+        budget = op["budget"].toDouble();
+    }
+}
+
+void Journal::applyTodo(const QJsonObject &op, const QDate &date,
+                        QVector<Todo> &todos, QVector<bool> &done)
+{
+    const QString type = op["op"].toString();
+    const int index = op["index"].toInt(-1);
+    const bool valid = (index >= 0 && index < todos.size() && index < done.size());
+
+    if (type == "add") {
+        bool d = false;
+        todos.append(TodoStore::fromJson(op["item"].toObject(), date, &d));
+        done.append(d);
+    } else if (type == "insert") {
+        if (index >= 0 && index <= todos.size() && index <= done.size()) {
+            bool d = false;
+            todos.insert(index, TodoStore::fromJson(op["item"].toObject(), date, &d));
+            done.insert(index, d);
+        }
+    } else if (type == "update") {
+        if (valid) {
+            bool d = false;
+            todos[index] = TodoStore::fromJson(op["item"].toObject(), date, &d);
+            done[index] = d;
+        }
+    } else if (type == "remove") {
+        if (valid) {
+            todos.removeAt(index);
+            done.removeAt(index);
+        }
+    } else if (type == "toggle") {
+        if (valid) done[index] = op["done"].toBool();
+    }
+}
+
+bool Journal::loadLedger(const QDate &date, QVector<AccountItem> &items, bool &hasBudget, double &budget)
+{
+    QMutexLocker lock(&m_mutex);
+
+    QString batch;
+    bool exists = Account::readDayFile(date, items, hasBudget, budget, &batch);
+    const bool compacted = !m_batch.isEmpty() && batch == m_batch;
+
+    int applied = 0;
+    for (const auto *ops : {&m_compacting, &m_ops}) {
+        if (ops == &m_compacting && compacted) continue;   // 這批已經在日檔裡
+        for (const auto &op : ops->value(date)) {
+            if (op["kind"].toString() != "ledger") continue;
+            applyLedger(op, date, items, hasBudget, budget);
+            applied++;
+        }
+    }
+    return exists || applied > 0;
+}
+
+bool Journal::loadTodos(const QDate &date, QVector<Todo> &todos, QVector<bool> &done)
+{
+    QMutexLocker lock(&m_mutex);
+
+    QString batch;
+    bool exists = TodoStore::readDayFile(date, todos, done, &batch);
+    const bool compacted = !m_batch.isEmpty() && batch == m_batch;
+
+    int applied = 0;
+    for (const auto *ops : {&m_compacting, &m_ops}) {
+        if (ops == &m_compacting && compacted) continue;
+        for (const auto &op : ops->value(date)) {
+            if (op["kind"].toString() != "todo") continue;
+            applyTodo(op, date, todos, done);
+            applied++;
+        }
+    }
+    return exists || applied > 0;
+}
+
+// ✅ 把目前的日誌換成 journal.compacting，背景逐日寫回日檔
+// 上一批還有沒寫成功的日子就先重試那些，壓完再換下一批
+void Journal::compactAsync()
+{
+    QMutexLocker lock(&m_mutex);
+    if (m_compactionRunning) return;
+
+    if (!m_compacting.isEmpty()) {
+        m_compactionRunning = true;
+        m_pool.start([this]{ compactPending(); });
+        return;
+    }
+    if (m_ops.isEmpty()) return;
+
+    m_file.close();
+    QFile::remove(kCompactingPath);
+    if (!QFile::rename(kJournalPath, kCompactingPath)) {
+        m_file.open(QIODevice::WriteOnly | QIODevice::Append);
+        return;
+    }
+
+    // 每一批有自己的 id：日檔寫入時一起記下，同一批不會重播兩次
+    m_batch = QUuid::createUuid().toString();
+    QJsonObject header;
+    header["op"] = "batch";
+    header["id"] = m_batch;
+    QFile marks(kCompactingPath);
+    if (marks.open(QIODevice::WriteOnly | QIODevice::Append))
+        marks.write(toLine(header));
+    marks.close();
+
+    m_compacting = m_ops;
+    m_ops.clear();
+    m_count = 0;
+    m_file.open(QIODevice::WriteOnly | QIODevice::Append);
+
+    m_compactionRunning = true;
+    m_pool.start([this]{ compactPending(); });
+}
+
+void Journal::compactPending()
+{
+    QList<QDate> dates;
+    {
+        QMutexLocker lock(&m_mutex);
+        dates = m_compacting.keys();
+    }
+
+    QFile marks(kCompactingPath);
+    marks.open(QIODevice::WriteOnly | QIODevice::Append);
+
+    for (const QDate &date : dates) {
+        // 每天整段持鎖：讀檔的一方不會看到寫到一半、或被重播兩次的日檔
+        QMutexLocker lock(&m_mutex);
+        const QVector<QJsonObject> ops = m_compacting.value(date);
+
+        bool hasLedger = false, hasTodo = false;
+        for (const auto &op : ops) {
+            if (op["kind"].toString() == "ledger") hasLedger = true;
+            else if (op["kind"].toString() == "todo") hasTodo = true;
+        }
+
+        // 日檔帶著這一批的 id 表示已經寫過（上次只寫成一半、或寫完還沒標記就當掉），不再套用
+        bool ok = true;
+        if (hasLedger) {
+            QVector<AccountItem> items;
+            bool hasBudget = false;
+            double budget = 0.0;
+            QString batch;
+            Account::readDayFile(date, items, hasBudget, budget, &batch);
+            if (m_batch.isEmpty() || batch != m_batch) {
+                for (const auto &op : ops) {
+                    if (op["kind"].toString() == "ledger")
+                        applyLedger(op, date, items, hasBudget, budget);
+                }
+                ok = Account::writeDayFile(date, items, budget, m_batch) && ok;
+            }
+        }
+        if (hasTodo) {
+            QVector<Todo> todos;
+            QVector<bool> done;
+            QString batch;
+            TodoStore::readDayFile(date, todos, done, &batch);
+            if (m_batch.isEmpty() || batch != m_batch) {
+                for (const auto &op : ops) {
+                    if (op["kind"].toString() == "todo")
+                        applyTodo(op, date, todos, done);
+                }
+                ok = TodoStore::writeDayFile(date, todos, done, m_batch) && ok;
+            }
+        }
+
+        if (!ok) continue;   // 留在 journal.compacting，下次 compactAsync 或啟動時再試
+
+        QJsonObject mark;
+        mark["op"] = "compacted";
+        mark["date"] = date.toString(Qt::ISODate);
+        marks.write(toLine(mark));
+        marks.flush();
+
+        m_compacting.remove(date);
+    }
+
+    marks.close();
+
+    bool again = false;
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_compacting.isEmpty()) {
+            QFile::remove(kCompactingPath);
+            m_batch.clear();
+            // 重試期間日誌又累積夠多，接著壓下一批
+            again = (m_count >= kCompactThreshold);
+        }
+        m_compactionRunning = false;
+    }
+    if (again) compactAsync();
+}
+
+void Journal::waitForCompaction()
+{
+    m_pool.waitForDone();
+}
+
+int Journal::pendingOps() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_count;
+}
+
+QSet<QDate> Journal::pendingDates(const QString &kind) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    QSet<QDate> dates;
+    for (const auto *ops : {&m_compacting, &m_ops}) {
+        for (auto it = ops->constBegin(); it != ops->constEnd(); ++it) {
+            for (const auto &op : it.value()) {
+                if (op["kind"].toString() == kind) {
+                    dates.insert(it.key());
+                    break;
+                }
+            }
+        }
+    }
+    return dates;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <QDate>
+#include <QFile>
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+#include "account.h"
+#include "models.h"
+
+// ✅ 追加式日誌：CALENDAR_STORAGE=journal 時啟用
+// 每次異動（add / insert / update / remove / toggle / budget）只追加一行到 data/journal.log，
+// 讀檔時以日檔為底重播，累積夠多就在背景壓回日檔
+class Journal
+{
+public:
+    static bool enabled();
+    static Journal& instance();
+
+    // 異動紀錄（kind / date 由 append 補上）
+    static QJsonObject opAdd(const QJsonObject &payload);
+    static QJsonObject opUpdate(int index, const QJsonObject &payload);
+    static QJsonObject opRemove(int index);
+    static QJsonObject opInsert(int index, const QJsonObject &payload);   // 復原刪除：放回原位
+    static QJsonObject opToggle(int index, bool done);
+    static QJsonObject opBudget(double budget);
+
+    bool append(const QDate &date, const QString &kind, const QVector<QJsonObject> &ops);
+
+    // 日檔 + 日誌重播；有任何資料回傳 true
+    bool loadLedger(const QDate &date, QVector<AccountItem> &items, bool &hasBudget, double &budget);
+    bool loadTodos(const QDate &date, QVector<Todo> &todos, QVector<bool> &done);
+
+    void compactAsync();
+    void waitForCompaction();
+
+    int pendingOps() const;
+    // 日誌裡（含正在壓縮的）有 kind（"ledger" / "todo"）異動的日子，可能還沒有日檔
+    QSet<QDate> pendingDates(const QString &kind) const;
+
+private:
+    Journal();
+    ~Journal();
+
+    void loadFromDisk();
+    void compactPending();
+
+    static void applyLedger(const QJsonObject &op, const QDate &date,
+                            QVector<AccountItem> &items, bool &hasBudget, double &budget);
+    static void applyTodo(const QJsonObject &op, const QDate &date,
+                          QVector<Todo> &todos, QVector<bool> &done);
+
+    mutable QMutex m_mutex;
+    QHash<QDate, QVector<QJsonObject>> m_ops;         // journal.log
+    QHash<QDate, QVector<QJsonObject>> m_compacting;  // journal.compacting，背景正在壓回日檔
+    QString m_batch;                // journal.compacting 的批次 id，壓縮時寫進日檔
+    QFile m_file;
+    int m_count = 0;
+
+    QThreadPool m_pool;             // 壓縮用的單一背景執行緒
+    bool m_compactionRunning = false;
+};
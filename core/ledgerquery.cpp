@@ -0,0 +1,82 @@
+#include "ledgerquery.h"
+#include "columnarledger.h"
+#include "daystore.h"
+#include "journal.h"
+#include "recurrence.h"
+
+// 超過這麼多個月的區間用欄式帳本
+static const int kColumnarMonths = 24;
+
+static void addDay(RangeTotals &out, const DayTotal &t)
+{
+    out.income  += t.income;
+    out.expense += t.expense;
+    out.count   += t.count;
+
+    for (auto it = t.categories.constBegin(); it != t.categories.constEnd(); ++it) {
+        CategoryTotal &c = out.categories[it.key()];
+        c.income  += it.value().income;
+        c.expense += it.value().expense;
+        c.count   += it.value().count;
+    }
+}
+
+// ✅ 週期規則不寫日檔，統計時才展開區間內的每一次疊上去
+static void addRecurring(RangeTotals &out, const QDate &from, const QDate &to)
+{
+    const QMap<QDate, DayTotal> days = RecurrenceStore::instance().ledgerTotals(from, to);
+    for (const DayTotal &t : days)
+        addDay(out, t);
+}
+
+RangeTotals LedgerQuery::aggregate(const QDate &from, const QDate &to)
+{
+    RangeTotals out;
+    if (!from.isValid() || !to.isValid() || to < from) return out;
+
+    // ✅ 有索引的後端：整段一個 GROUP BY
+    const DayStore &store = DayStore::instance();
+    if (store.indexed()) {
+        out = store.aggregate(from, to);
+        addRecurring(out, from, to);
+        return out;
+    }
+
+    // ✅ 跨好幾年的區間改走欄式帳本（journal 模式的日檔可能還沒壓回，仍走月摘要）
+    const int months = (to.year() - from.year()) * 12 + (to.month() - from.month()) + 1;
+    if (months > kColumnarMonths && !Journal::enabled()) {
+        ColumnarLedger &col = ColumnarLedger::instance();
+        if (col.sync()) {
+            ColumnarTotals t = col.sum(from, to);
+            out.income = double(t.income);
+            out.expense = double(t.expense);
+            out.count = t.count;
+            out.categories = col.byCategory(from, to);
+            addRecurring(out, from, to);
+            return out;
+        }
+    }
+
+    QDate m(from.year(), from.month(), 1);
+    const QDate last(to.year(), to.month(), 1);
+
+    for (; m <= last; m = m.addMonths(1)) {
+        MonthSummary ms = MonthSummary::load(m.year(), m.month());
+
+        // 頭尾月份只取區間內的日子，中間整月全拿
+        int lo = (m.year() == from.year() && m.month() == from.month()) ? from.day() : 1;
+        int hi = (m.year() == to.year() && m.month() == to.month()) ? to.day() : m.daysInMonth();
+
+        const auto &days = ms.days();
+        for (auto it = days.lowerBound(lo); it != days.constEnd() && it.key() <= hi; ++it)
+            addDay(out, it.value());
+    }
+    addRecurring(out, from, to);
+    return out;
+}
+
+RangeTotals LedgerQuery::month(int year, int month)
+{
+    QDate first(year, month, 1);
+    return aggregate(first, QDate(year, month, first.daysInMonth()));
+}
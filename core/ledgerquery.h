@@ -0,0 +1,23 @@
+#pragma once
+#include <QDate>
+#include <QHash>
+#include <QString>
+
+#include "monthsummary.h"
+
+struct RangeTotals {
+    double income = 0;
+    double expense = 0;
+    int count = 0;
+    QHash<QString, CategoryTotal> categories;
+
+    double net() const { return income - expense; }
+};
+
+// ✅ 任意 [from, to] 區間的收支統計：逐月讀摘要，一次走完
+class LedgerQuery
+{
+public:
+    static RangeTotals aggregate(const QDate &from, const QDate &to);
+    static RangeTotals month(int year, int month);
+};
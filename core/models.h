@@ -0,0 +1,42 @@
+#pragma once
+#include <QString>
+#include <QDate>
+#include <QDateTime>
+
+// ✅ 收支類型：檔案裡仍存 "income" / "expense" 字串
+enum class EntryType : quint8 {
+    Expense = 0,
+    Income  = 1,
+    Other   = 2,
+};
+
+inline QString entryTypeName(EntryType t)
+{
+    switch (t) {
+    case EntryType::Income:  return QStringLiteral("income");
+    case EntryType::Expense: return QStringLiteral("expense");
+    default:                 return QStringLiteral("other");
+    }
+}
+
+inline EntryType entryTypeFromName(const QString &s)
+{
+    if (s == QLatin1String("income"))  return EntryType::Income;
+    if (s == QLatin1String("expense")) return EntryType::Expense;
+    return EntryType::Other;
+}
+
+struct Txn {
+    QDate date;
+    quint16 categoryId = 0;   // CategoryTable
+    int amount = 0;
+    EntryType type = EntryType::Expense;
+};
+
+struct Todo {
+    QString id;
+    QString title;
+    bool allDay = true;
+    QDateTime start;
+    QDateTime end;
+};
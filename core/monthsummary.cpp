@@ -0,0 +1,228 @@
+#include "monthsummary.h"
+#include "trace.h"
+#include "daycache.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSet>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+MonthSummary::MonthSummary(int year, int month)
+    : m_year(year), m_month(month)
+{
+}
+
+QString MonthSummary::filePath(int year, int month)
+{
+    QDir dir("data");
+    if (!dir.exists()) dir.mkpath(".");
+    return QString("data/summary_%1-%2.json")
+        .arg(year)
+        .arg(month, 2, 10, QChar('0'));
+}
+
+QString MonthSummary::dayFilePath(const QDate &date)
+{
+    return QString("data/%1.json").arg(date.toString("yyyy-MM-dd"));
+}
+
+MonthSummary MonthSummary::load(int year, int month)
+{
+    MonthSummary s(year, month);
+    s.readFile();
+    if (s.refresh())
+        s.save();
+    return s;
+}
+
+bool MonthSummary::updateDay(const QDate &date, const QVector<AccountItem> &items)
+{
+    // 不做 refresh：其他天缺的話，下次 load() 會自己補
+    MonthSummary s(date.year(), date.month());
+    s.readFile();
+
+    QFileInfo fi(dayFilePath(date));
+    qint64 mtime = fi.exists() ? fi.lastModified().toMSecsSinceEpoch() : 0;
+    s.setDay(date.day(), items, mtime);
+    return s.save();
+}
+
+double MonthSummary::income() const
+{
+    double sum = 0;
+    for (const auto &d : m_days) sum += d.income;
+    return sum;
+}
+
+double MonthSummary::expense() const
+{
+    double sum = 0;
+    for (const auto &d : m_days) sum += d.expense;
+    return sum;
+}
+
+int MonthSummary::count() const
+{
+    int n = 0;
+    for (const auto &d : m_days) n += d.count;
+    return n;
+}
+
+QHash<QString, CategoryTotal> MonthSummary::categories() const
+{
+    QHash<QString, CategoryTotal> out;
+    for (const auto &d : m_days) {
+        for (auto it = d.categories.constBegin(); it != d.categories.constEnd(); ++it) {
+            CategoryTotal &c = out[it.key()];
+            c.income  += it.value().income;
+            c.expense += it.value().expense;
+            c.count   += it.value().count;
+        }
+    }
+    return out;
+}
+
+void MonthSummary::setDay(int day, const QVector<AccountItem> &items, qint64 mtime)
+{
+    DayTotal t;
+    t.mtime = mtime;
+    for (const auto &item : items) {
+        CategoryTotal &c = t.categories[item.category()];
+        if (item.type == EntryType::Income) {
+            t.income += item.amount;
+            c.income += item.amount;
+        } else if (item.type == EntryType::Expense) {
+            t.expense += item.amount;
+            c.expense += item.amount;
+        }
+        t.count++;
+        c.count++;
+    }
+    m_days[day] = t;
+}
+
+// ✅ 一次列出當月日檔，只重讀修改時間不同的那幾天
+bool MonthSummary::refresh()
+{
+    const QString prefix = QString("%1-%2-")
+                               .arg(m_year)
+                               .arg(m_month, 2, 10, QChar('0'));
+
+    QDir dir("data");
+    const QFileInfoList files = dir.entryInfoList(QStringList{prefix + "??.json"}, QDir::Files);
+
+    bool changed = false;
+    QSet<int> seen;
+
+    for (const QFileInfo &fi : files) {
+        int day = fi.fileName().mid(prefix.size(), 2).toInt();
+        QDate date(m_year, m_month, day);
+        if (!date.isValid()) continue;
+
+        seen.insert(day);
+        qint64 mtime = fi.lastModified().toMSecsSinceEpoch();
+
+        auto it = m_days.constFind(day);
+        if (it != m_days.constEnd() && it->mtime == mtime)
+            continue;
+
+        // 日檔被外部改過：快取裡那天也不能再用
+        DayCache::instance().invalidate(date);
+
+        Account temp;
+        temp.loadFromFile(date);
+        setDay(day, temp.getItems(), mtime);
+        changed = true;
+    }
+
+    // mtime 為 0 的是還只在 journal 裡、沒有日檔的日子，不能當成被刪掉
+    for (auto it = m_days.begin(); it != m_days.end(); ) {
+        if (!seen.contains(it.key()) && it->mtime != 0) {
+            it = m_days.erase(it);
+            changed = true;
+        } else {
+            ++it;
+        }
+    }
+
+    return changed;
+}
+
+bool MonthSummary::readFile()
+{
+    m_days.clear();
+
+    QFile f(filePath(m_year, m_month));
+    if (!f.open(QIODevice::ReadOnly)) return false;
+
+    const QByteArray data = f.readAll();
+    f.close();
+    TRACE_COUNT("file.opens", 1);
+    TRACE_COUNT("file.bytesRead", data.size());
+    TRACE_SCOPE_CAT("parse.monthSummary", "parse");
+
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+
+    QJsonObject days = doc.object()["days"].toObject();
+    for (auto it = days.constBegin(); it != days.constEnd(); ++it) {
+        QJsonObject o = it.value().toObject();
+
+        DayTotal t;
+        t.income  = o["income"].toDouble();
+        t.expense = o["expense"].toDouble();
+        t.count   = o["count"].toInt();
+        t.mtime   = qint64(o["mtime"].toDouble());
+
+        QJsonObject cats = o["categories"].toObject();
+        for (auto c = cats.constBegin(); c != cats.constEnd(); ++c) {
+            QJsonObject co = c.value().toObject();
+            CategoryTotal ct;
+            ct.income  = co["income"].toDouble();
+            ct.expense = co["expense"].toDouble();
+            ct.count   = co["count"].toInt();
+            t.categories.insert(c.key(), ct);
+        }
+
+        m_days.insert(it.key().toInt(), t);
+    }
+    return true;
+}
+
+bool MonthSummary::save() const
+{
+    QJsonObject days;
+    for (auto it = m_days.constBegin(); it != m_days.constEnd(); ++it) {
+        const DayTotal &t = it.value();
+
+        QJsonObject cats;
+        for (auto c = t.categories.constBegin(); c != t.categories.constEnd(); ++c) {
+            QJsonObject co;
+            co["income"]  = c.value().income;
+            co["expense"] = c.value().expense;
+            co["count"]   = c.value().count;
+            cats[c.key()] = co;
+        }
+
+        QJsonObject o;
+        o["income"]  = t.income;
+        o["expense"] = t.expense;
+        o["count"]   = t.count;
+        o["mtime"]   = double(t.mtime);
+        o["categories"] = cats;
+
+        days[QString("%1").arg(it.key(), 2, 10, QChar('0'))] = o;
+    }
+
+    QJsonObject root;
+    root["income"]  = income();
+    root["expense"] = expense();
+    root["days"]    = days;
+
+    QSaveFile f(filePath(m_year, m_month));
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(QJsonDocument(root).toJson());
+    return f.commit();
+}
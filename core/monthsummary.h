@@ -0,0 +1,57 @@
+#pragma once
+#include <QString>
+#include <QDate>
+#include <QHash>
+#include <QMap>
+#include <QVector>
+
+#include "account.h"
+
+struct CategoryTotal {
+    double income = 0;
+    double expense = 0;
+    int count = 0;
+};
+
+struct DayTotal {
+    double income = 0;
+    double expense = 0;
+    int count = 0;
+    qint64 mtime = 0;   // 來源 data/yyyy-MM-dd.json 的修改時間（ms）
+    QHash<QString, CategoryTotal> categories;
+};
+
+// ✅ 月摘要：data/summary_yyyy-MM.json
+// 記錄當月每天的收支與類別統計，月查詢只讀這一個小檔
+class MonthSummary
+{
+public:
+    MonthSummary(int year, int month);
+
+    // 讀摘要檔；缺檔或與日檔修改時間不符就重建
+    static MonthSummary load(int year, int month);
+
+    // saveToFile 之後呼叫：只更新那一天
+    static bool updateDay(const QDate &date, const QVector<AccountItem> &items);
+
+    double income() const;
+    double expense() const;
+    int count() const;
+    QHash<QString, CategoryTotal> categories() const;
+
+    const QMap<int, DayTotal>& days() const { return m_days; }
+
+    bool save() const;
+
+private:
+    bool readFile();
+    bool refresh();
+    void setDay(int day, const QVector<AccountItem> &items, qint64 mtime);
+
+    static QString filePath(int year, int month);
+    static QString dayFilePath(const QDate &date);
+
+    int m_year;
+    int m_month;
+    QMap<int, DayTotal> m_days;
+};
@@ -0,0 +1,327 @@
+#include "recurrence.h"
+#include "todostore.h"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QUuid>
+#include <algorithm>
+
+static const char *kRulesPath = "data/recurring.json";
+static const char *kFreqNames[] = { "daily", "weekly", "monthly", "yearly" };
+
+// ===== RecurrenceRule =====
+
+QDate RecurrenceRule::nth(int n) const
+{
+    const int step = qMax(1, interval) * n;
+    switch (freq) {
+    case Daily:  return start.addDays(step);
+    case Weekly: return start.addDays(qint64(step) * 7);
+    case Monthly: {
+        const QDate first = QDate(start.year(), start.month(), 1).addMonths(step);
+        return QDate(first.year(), first.month(), qMin(start.day(), first.daysInMonth()));
+    }
+    case Yearly: {
+        const QDate first = QDate(start.year(), start.month(), 1).addYears(step);
+        return QDate(first.year(), first.month(), qMin(start.day(), first.daysInMonth()));
+    }
+    }
+    return QDate();
+}
+
+// 估計 date 之前（含）最後一次的序號，可能差一次，呼叫端自己往後走
+static int indexNear(const RecurrenceRule &r, const QDate &date)
+{
+    const int every = qMax(1, r.interval);
+    switch (r.freq) {
+    case RecurrenceRule::Daily:  return int(r.start.daysTo(date) / every);
+    case RecurrenceRule::Weekly: return int(r.start.daysTo(date) / (7 * every));
+    case RecurrenceRule::Monthly:
+        return ((date.year() - r.start.year()) * 12 + date.month() - r.start.month()) / every;
+    case RecurrenceRule::Yearly:
+        return (date.year() - r.start.year()) / every;
+    }
+    return 0;
+}
+
+bool RecurrenceRule::occursOn(const QDate &date) const
+{
+    if (!start.isValid() || !date.isValid() || date < start) return false;
+    if (until.isValid() && date > until) return false;
+    if (exceptions.contains(date)) return false;
+    return nth(indexNear(*this, date)) == date;
+}
+
+QVector<QDate> RecurrenceRule::occurrences(const QDate &from, const QDate &to) const
+{
+    QVector<QDate> out;
+    if (!start.isValid()) return out;
+
+    const QDate lo = qMax(from, start);
+    const QDate hi = until.isValid() ? qMin(to, until) : to;
+    if (lo > hi) return out;
+
+    for (int n = qMax(0, indexNear(*this, lo)); ; ++n) {
+        const QDate d = nth(n);
+        if (!d.isValid() || d > hi) break;
+        if (d >= lo && !exceptions.contains(d)) out.append(d);
+    }
+    return out;
+}
+
+AccountItem RecurrenceRule::itemOn(const QDate &date) const
+{
+    AccountItem a = item;
+    a.date = date;
+    return a;
+}
+
+Todo RecurrenceRule::todoOn(const QDate &date) const
+{
+    Todo td = todo;
+    const qint64 span = todo.start.date().daysTo(todo.end.date());   // 跨夜的待辦
+    td.start = QDateTime(date, todo.start.time());
+    td.end = QDateTime(date.addDays(qMax<qint64>(0, span)), todo.end.time());
+    return td;
+}
+
+// ===== JSON =====
+
+static QJsonArray datesToJson(const QSet<QDate> &dates)
+{
+    QList<QDate> sorted = dates.values();
+    std::sort(sorted.begin(), sorted.end());
+    QJsonArray arr;
+    for (const QDate &d : sorted)
+        arr.append(d.toString(Qt::ISODate));
+    return arr;
+}
+
+static QSet<QDate> datesFromJson(const QJsonArray &arr)
+{
+    QSet<QDate> out;
+    for (const auto &v : arr) {
+        const QDate d = QDate::fromString(v.toString(), Qt::ISODate);
+        if (d.isValid()) out.insert(d);
+    }
+    return out;
+}
+
+static QJsonObject ruleToJson(const RecurrenceRule &r)
+{
+    QJsonObject o;
+    o["id"] = r.id;
+    o["freq"] = QString::fromLatin1(kFreqNames[r.freq]);
+    o["interval"] = r.interval;
+    o["start"] = r.start.toString(Qt::ISODate);
+    if (r.until.isValid()) o["until"] = r.until.toString(Qt::ISODate);
+    if (!r.exceptions.isEmpty()) o["except"] = datesToJson(r.exceptions);
+
+    if (r.isTodo) {
+        o["todo"] = TodoStore::toJson(r.todo, false);
+        if (!r.done.isEmpty()) o["done"] = datesToJson(r.done);
+    } else {
+        o["item"] = Account::itemToJson(r.item);
+    }
+    return o;
+}
+
+static bool ruleFromJson(const QJsonObject &o, RecurrenceRule &r)
+{
+    r.id = o["id"].toString();
+    r.start = QDate::fromString(o["start"].toString(), Qt::ISODate);
+    r.until = QDate::fromString(o["until"].toString(), Qt::ISODate);
+    r.interval = qMax(1, o["interval"].toInt(1));
+
+    const QString freq = o["freq"].toString();
+    bool known = false;
+    for (int i = 0; i < 4; ++i) {
+        if (freq == QLatin1String(kFreqNames[i])) {
+            r.freq = RecurrenceRule::Freq(i);
+            known = true;
+        }
+    }
+
+    r.exceptions = datesFromJson(o["except"].toArray());
+    r.isTodo = o.contains("todo");
+    if (r.isTodo) {
+        r.todo = TodoStore::fromJson(o["todo"].toObject(), r.start);
+        r.done = datesFromJson(o["done"].toArray());
+    } else {
+        r.item = Account::itemFromJson(o["item"].toObject(), r.start);
+    }
+    return known && !r.id.isEmpty() && r.start.isValid();
+}
+
+// ===== RecurrenceStore =====
+
+RecurrenceStore& RecurrenceStore::instance()
+{
+    static RecurrenceStore store;
+    return store;
+}
+
+QString RecurrenceStore::filePath()
+{
+    QDir dir("data");
+    if (!dir.exists()) dir.mkpath(".");
+    return QString::fromLatin1(kRulesPath);
+}
+
+QString RecurrenceStore::newId()
+{
+    return QUuid::createUuid().toString(QUuid::WithoutBraces);
+}
+
+void RecurrenceStore::ensureLoaded() const
+{
+    if (m_loaded) return;
+    m_loaded = true;
+
+    QFile f(filePath());
+    if (!f.open(QIODevice::ReadOnly)) return;   // 還沒有規則
+
+    const QJsonArray arr = QJsonDocument::fromJson(f.readAll()).object()["rules"].toArray();
+    for (const auto &v : arr) {
+        RecurrenceRule r;
+        if (ruleFromJson(v.toObject(), r)) m_rules.append(r);
+    }
+}
+
+int RecurrenceStore::indexOf(const QString &id) const
+{
+    for (int i = 0; i < m_rules.size(); ++i)
+        if (m_rules[i].id == id) return i;
+    return -1;
+}
+
+QVector<RecurrenceRule> RecurrenceStore::rules() const
+{
+    QMutexLocker lock(&m_mutex);
+    ensureLoaded();
+    return m_rules;
+}
+
+void RecurrenceStore::add(const RecurrenceRule &rule)
+{
+    QMutexLocker lock(&m_mutex);
+    ensureLoaded();
+    m_rules.append(rule);
+    m_dirty = true;
+}
+
+bool RecurrenceStore::remove(const QString &id)
+{
+    QMutexLocker lock(&m_mutex);
+    ensureLoaded();
+    const int i = indexOf(id);
+    if (i < 0) return false;
+    m_rules.removeAt(i);
+    m_dirty = true;
+    return true;
+}
+
+bool RecurrenceStore::skip(const QString &id, const QDate &date)
+{
+    QMutexLocker lock(&m_mutex);
+    ensureLoaded();
+    const int i = indexOf(id);
+    if (i < 0) return false;
+    m_rules[i].exceptions.insert(date);
+    m_rules[i].done.remove(date);
+    m_dirty = true;
+    return true;
+}
+
+bool RecurrenceStore::setDone(const QString &id, const QDate &date, bool done)
+{
+    QMutexLocker lock(&m_mutex);
+    ensureLoaded();
+    const int i = indexOf(id);
+    if (i < 0) return false;
+    if (done) m_rules[i].done.insert(date);
+    else m_rules[i].done.remove(date);
+    m_dirty = true;
+    return true;
+}
+
+bool RecurrenceStore::save()
+{
+    QMutexLocker lock(&m_mutex);
+    if (!m_dirty) return true;
+
+    QJsonArray arr;
+    for (const auto &r : m_rules)
+        arr.append(ruleToJson(r));
+    QJsonObject root;
+    root["rules"] = arr;
+
+    QSaveFile f(filePath());
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    if (!f.commit()) return false;
+
+    m_dirty = false;
+    return true;
+}
+
+QVector<RecurringLedger> RecurrenceStore::ledgerOn(const QDate &date) const
+{
+    QMutexLocker lock(&m_mutex);
+    ensureLoaded();
+
+    QVector<RecurringLedger> out;
+    for (const auto &r : m_rules)
+        if (!r.isTodo && r.occursOn(date)) out.append({ r.id, r.itemOn(date) });
+    return out;
+}
+
+QVector<RecurringTodo> RecurrenceStore::todosOn(const QDate &date) const
+{
+    QMutexLocker lock(&m_mutex);
+    ensureLoaded();
+
+    QVector<RecurringTodo> out;
+    for (const auto &r : m_rules)
+        if (r.isTodo && r.occursOn(date)) out.append({ r.id, r.todoOn(date), r.done.contains(date) });
+    return out;
+}
+
+QSet<QDate> RecurrenceStore::datesIn(const QDate &from, const QDate &to) const
+{
+    QMutexLocker lock(&m_mutex);
+    ensureLoaded();
+
+    QSet<QDate> out;
+    for (const auto &r : m_rules)
+        for (const QDate &d : r.occurrences(from, to))
+            out.insert(d);
+    return out;
+}
+
+QMap<QDate, DayTotal> RecurrenceStore::ledgerTotals(const QDate &from, const QDate &to) const
+{
+    QMutexLocker lock(&m_mutex);
+    ensureLoaded();
+
+    QMap<QDate, DayTotal> out;
+    for (const auto &r : m_rules) {
+        if (r.isTodo || r.item.type == EntryType::Other) continue;
+
+        const bool income = r.item.type == EntryType::Income;
+        const QString cat = r.item.category();
+        for (const QDate &d : r.occurrences(from, to)) {
+            DayTotal &t = out[d];
+            CategoryTotal &c = t.categories[cat];
+            (income ? t.income : t.expense) += r.item.amount;
+            (income ? c.income : c.expense) += r.item.amount;
+            t.count++;
+            c.count++;
+        }
+    }
+    return out;
+}
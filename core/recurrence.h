@@ -0,0 +1,91 @@
+#pragma once
+#include <QDate>
+#include <QMap>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include "account.h"
+#include "models.h"
+#include "monthsummary.h"
+
+// ✅ 週期規則：房租、薪水、每週吃藥…只存一次，看到哪段才展開哪段
+// 每月 31 號 / 2 月 29 號這種日子，遇到比較短的月份就落在月底
+struct RecurrenceRule {
+    enum Freq : quint8 { Daily, Weekly, Monthly, Yearly };
+
+    QString id;
+    Freq freq = Monthly;
+    int interval = 1;          // 每 n 天 / 週 / 月 / 年
+    QDate start;               // 第一次
+    QDate until;               // 無效 = 沒有結束日
+    QSet<QDate> exceptions;    // 略過的那幾次
+
+    bool isTodo = false;
+    AccountItem item;          // 記帳：date 不用
+    Todo todo;                 // 待辦：只取開始 / 結束的時間
+    QSet<QDate> done;          // 待辦：已完成的那幾次
+
+    bool occursOn(const QDate &date) const;
+    // [from, to] 內的每一次（已扣掉 exceptions），依日期排序
+    QVector<QDate> occurrences(const QDate &from, const QDate &to) const;
+
+    // 第 n 次（不看 until / exceptions）
+    QDate nth(int n) const;
+    // 某天那一次的實際內容
+    AccountItem itemOn(const QDate &date) const;
+    Todo todoOn(const QDate &date) const;
+};
+
+// 清單上的虛擬列：記得是哪條規則展開的，右鍵才能略過 / 刪掉整個週期
+struct RecurringLedger {
+    QString ruleId;
+    AccountItem item;
+};
+
+struct RecurringTodo {
+    QString ruleId;
+    Todo todo;
+    bool done = false;
+};
+
+// ✅ data/recurring.json：所有規則一個檔，第一次用到才讀
+// 展開結果不寫回日檔；月統計、每日索引、白點、清單各自查這裡再疊上去
+class RecurrenceStore
+{
+public:
+    static RecurrenceStore& instance();
+    static QString filePath();
+
+    // 新 id（建立規則時用）
+    static QString newId();
+
+    QVector<RecurrenceRule> rules() const;
+
+    void add(const RecurrenceRule &rule);
+    bool remove(const QString &id);
+    bool skip(const QString &id, const QDate &date);
+    bool setDone(const QString &id, const QDate &date, bool done);
+
+    // 沒有變動就不寫
+    bool save();
+
+    QVector<RecurringLedger> ledgerOn(const QDate &date) const;
+    QVector<RecurringTodo> todosOn(const QDate &date) const;
+    // 有任何一次落在區間內的日子（行事曆白點）
+    QSet<QDate> datesIn(const QDate &from, const QDate &to) const;
+    // 記帳規則在區間內每天的收支（key = 日期）
+    QMap<QDate, DayTotal> ledgerTotals(const QDate &from, const QDate &to) const;
+
+private:
+    RecurrenceStore() = default;
+
+    void ensureLoaded() const;   // 要先拿到 m_mutex
+    int indexOf(const QString &id) const;
+
+    mutable QMutex m_mutex;
+    mutable bool m_loaded = false;
+    mutable QVector<RecurrenceRule> m_rules;
+    bool m_dirty = false;
+};
@@ -0,0 +1,275 @@
+#include "searchindex.h"
+#include "todostore.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+#include <algorithm>
+
+static const char *kIndexPath = "data/search.idx";
+static const quint32 kMagic = 0x43534958;   // "CSIX"
+static const quint32 kVersion = 1;
+
+SearchIndex& SearchIndex::instance()
+{
+    static SearchIndex idx;
+    return idx;
+}
+
+// ✅ 比對前統一：大小寫摺疊，只留文字與數字（空白、標點都拿掉）
+QString SearchIndex::normalize(const QString &text)
+{
+    QString out;
+    out.reserve(text.size());
+    for (QChar c : text.toCaseFolded())
+        if (c.isLetterOrNumber()) out.append(c);
+    return out;
+}
+
+// 相鄰兩字一個 gram；單字也收，查一個字時用得到
+QVector<quint32> SearchIndex::gramsOf(const QString &n)
+{
+    QVector<quint32> grams;
+    grams.reserve(n.size() * 2);
+    for (int i = 0; i < n.size(); ++i) {
+        grams.append(quint32(n[i].unicode()) << 16);
+        if (i + 1 < n.size())
+            grams.append((quint32(n[i].unicode()) << 16) | n[i + 1].unicode());
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+bool SearchIndex::isOpen() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_open;
+}
+
+void SearchIndex::open()
+{
+    QMutexLocker lock(&m_mutex);
+    if (m_open) return;
+
+    load();
+    if (refresh()) m_dirty = true;
+    m_open = true;
+
+    lock.unlock();
+    save();
+}
+
+void SearchIndex::setDoc(qint64 julian, bool todo, qint64 mtime, const QString &text)
+{
+    const qint64 key = keyOf(julian, todo);
+    auto it = m_byKey.constFind(key);
+    if (it != m_byKey.constEnd()) removeDoc(*it);
+    if (text.isEmpty()) return;
+
+    Doc d;
+    d.julian = julian;
+    d.todo = todo;
+    d.mtime = mtime;
+    d.text = text;
+    d.grams = gramsOf(normalize(text));
+
+    int id;
+    if (!m_free.isEmpty()) {
+        id = m_free.takeLast();
+        m_docs[id] = d;
+    } else {
+        id = m_docs.size();
+        m_docs.append(d);
+    }
+    m_byKey.insert(key, id);
+    for (quint32 g : m_docs[id].grams)
+        m_postings[g].append(id);
+}
+
+void SearchIndex::removeDoc(int id)
+{
+    Doc &d = m_docs[id];
+    for (quint32 g : d.grams) {
+        auto p = m_postings.find(g);
+        if (p == m_postings.end()) continue;
+        p->removeOne(id);
+        if (p->isEmpty()) m_postings.erase(p);
+    }
+    m_byKey.remove(keyOf(d.julian, d.todo));
+    d = Doc();
+    m_free.append(id);
+}
+
+static QString ledgerText(const QVector<AccountItem> &items)
+{
+    QStringList lines;
+    for (const auto &item : items)
+        lines.append(item.note.isEmpty() ? item.category() : item.category() + " " + item.note);
+    return lines.join('\n');
+}
+
+static QString todoText(const QVector<Todo> &todos)
+{
+    QStringList lines;
+    for (const auto &td : todos)
+        lines.append(td.title);
+    return lines.join('\n');
+}
+
+static qint64 fileMtime(const QString &path)
+{
+    QFileInfo fi(path);
+    return fi.exists() ? fi.lastModified().toMSecsSinceEpoch() : 0;
+}
+
+void SearchIndex::updateLedger(const QDate &date, const QVector<AccountItem> &items)
+{
+    QMutexLocker lock(&m_mutex);
+    if (!m_open) return;   // 還沒開過：之後 open() 會依修改時間重讀
+    setDoc(date.toJulianDay(), false, fileMtime(Account::filePath(date)), ledgerText(items));
+    m_dirty = true;
+}
+
+void SearchIndex::updateTodos(const QDate &date, const QVector<Todo> &todos)
+{
+    QMutexLocker lock(&m_mutex);
+    if (!m_open) return;
+    setDoc(date.toJulianDay(), true, fileMtime(TodoStore::filePath(date)), todoText(todos));
+    m_dirty = true;
+}
+
+// ✅ 列一次 data/，只重讀新檔與修改時間不同的日檔；日檔被刪掉的文件一併移除
+bool SearchIndex::refresh()
+{
+    QDir dir("data");
+    const QFileInfoList files = dir.entryInfoList(
+        QStringList{"????-??-??.json", "????-??-??.todo.json"}, QDir::Files);
+
+    bool changed = false;
+    QSet<qint64> seen;
+
+    for (const QFileInfo &fi : files) {
+        const QDate date = QDate::fromString(fi.fileName().left(10), "yyyy-MM-dd");
+        if (!date.isValid()) continue;
+
+        const bool todo = fi.fileName().endsWith(".todo.json");
+        const qint64 key = keyOf(date.toJulianDay(), todo);
+        const qint64 mtime = fi.lastModified().toMSecsSinceEpoch();
+        seen.insert(key);
+
+        auto it = m_byKey.constFind(key);
+        if (it != m_byKey.constEnd() && m_docs[*it].mtime == mtime) continue;
+
+        QString text;
+        if (todo) {
+            QVector<Todo> todos;
+            QVector<bool> done;
+            TodoStore::readDayFile(date, todos, done);
+            text = todoText(todos);
+        } else {
+            QVector<AccountItem> items;
+            bool hasBudget = false;
+            double budget = 0;
+            Account::readDayFile(date, items, hasBudget, budget);
+            text = ledgerText(items);
+        }
+        setDoc(date.toJulianDay(), todo, mtime, text);   // 空的日檔不留文件
+        changed = true;
+    }
+
+    // 修改時間 0 的是只在 journal 裡的日子，不能當成被刪掉
+    QVector<int> gone;
+    for (auto it = m_byKey.constBegin(); it != m_byKey.constEnd(); ++it)
+        if (!seen.contains(it.key()) && m_docs[*it].mtime != 0) gone.append(*it);
+    for (int id : gone) {
+        removeDoc(id);
+        changed = true;
+    }
+    return changed;
+}
+
+bool SearchIndex::load()
+{
+    QFile f(kIndexPath);
+    if (!f.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&f);
+    quint32 magic = 0, version = 0;
+    in >> magic >> version;
+    if (magic != kMagic || version != kVersion) return false;
+
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        qint64 julian = 0, mtime = 0;
+        bool todo = false;
+        QString text;
+        in >> julian >> todo >> mtime >> text;
+        setDoc(julian, todo, mtime, text);
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+bool SearchIndex::save()
+{
+    QMutexLocker lock(&m_mutex);
+    if (!m_dirty) return true;
+
+    QSaveFile f(kIndexPath);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+
+    QDataStream out(&f);
+    out << kMagic << kVersion << qint32(m_byKey.size());
+    for (int id : m_byKey)
+        out << m_docs[id].julian << m_docs[id].todo << m_docs[id].mtime << m_docs[id].text;
+
+    if (!f.commit()) return false;
+    m_dirty = false;
+    return true;
+}
+
+// ✅ 從最少文件的 gram 取候選，再用正規化後的全文確認（bigram 都在不代表字串相連）
+QVector<SearchHit> SearchIndex::search(const QString &query, int limit) const
+{
+    QVector<SearchHit> hits;
+    const QString q = normalize(query);
+    if (q.isEmpty()) return hits;
+
+    QMutexLocker lock(&m_mutex);
+
+    const QVector<quint32> grams = gramsOf(q);
+    const QVector<int> *rarest = nullptr;
+    for (quint32 g : grams) {
+        auto p = m_postings.constFind(g);
+        if (p == m_postings.constEnd()) return hits;   // 有一個 gram 沒出現過就不可能命中
+        if (!rarest || p->size() < rarest->size()) rarest = &*p;
+    }
+
+    for (int id : *rarest) {
+        const Doc &d = m_docs[id];
+
+        SearchHit h;
+        h.date = QDate::fromJulianDay(d.julian);
+        h.todo = d.todo;
+        for (const QString &line : d.text.split('\n')) {
+            const QString n = normalize(line);
+            if (!n.contains(q)) continue;
+            if (h.snippet.isEmpty()) h.snippet = line;
+            // 整行就是關鍵字（例如類別名稱）排前面
+            h.score += (n == q) ? 20 : 10;
+        }
+        if (h.score == 0) continue;   // 只是跨行湊出來的
+        hits.append(h);
+    }
+
+    std::sort(hits.begin(), hits.end(), [](const SearchHit &a, const SearchHit &b){
+        if (a.score != b.score) return a.score > b.score;
+        return a.date > b.date;   // 同分新的在前
+    });
+    if (hits.size() > limit) hits.resize(limit);
+    return hits;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <QDate>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include "account.h"
+#include "models.h"
+
+struct SearchHit {
+    QDate date;
+    bool todo = false;      // false：記帳（備註 / 類別），true：待辦標題
+    int score = 0;
+    QString snippet;        // 命中的那一行
+};
+
+// ✅ 全文搜尋：每天的記帳、待辦各一份文件，以字元 bigram 建倒排索引（中文不用斷詞）
+// 索引存在 data/search.idx；開啟時列一次 data/，只重讀修改時間變了的日檔
+// 開啟後 Account::saveToFile / TodoStore::save 會直接更新那一天
+class SearchIndex
+{
+public:
+    static SearchIndex& instance();
+
+    // 第一次搜尋前呼叫（背景執行緒）；已開啟就只回傳
+    void open();
+    bool isOpen() const;
+
+    QVector<SearchHit> search(const QString &query, int limit = 100) const;
+
+    void updateLedger(const QDate &date, const QVector<AccountItem> &items);
+    void updateTodos(const QDate &date, const QVector<Todo> &todos);
+
+    // 有變動才寫檔
+    bool save();
+
+    static QString normalize(const QString &text);
+
+private:
+    struct Doc {
+        qint64 julian = 0;
+        bool todo = false;
+        qint64 mtime = 0;       // 來源日檔的修改時間；0 = 只在 journal 裡
+        QString text;           // 一行一筆（類別 + 備註，或待辦標題）
+        QVector<quint32> grams;
+    };
+
+    SearchIndex() = default;
+
+    static QVector<quint32> gramsOf(const QString &normalized);
+    static qint64 keyOf(qint64 julian, bool todo) { return julian * 2 + (todo ? 1 : 0); }
+
+    bool load();
+    bool refresh();
+    void setDoc(qint64 julian, bool todo, qint64 mtime, const QString &text);
+    void removeDoc(int id);
+
+    mutable QMutex m_mutex;
+    bool m_open = false;
+    bool m_dirty = false;
+
+    QVector<Doc> m_docs;
+    QVector<int> m_free;                        // 空出來的文件編號
+    QHash<qint64, int> m_byKey;                 // (日期, 類型) → 文件編號
+    QHash<quint32, QVector<int>> m_postings;    // gram → 文件編號
+};
@@ -0,0 +1,517 @@
+#include "sqlitedaystore.h"
+#include "journal.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+
+struct SqliteDayStore::Connection {
+    QString name;
+    QSqlDatabase db;
+    QHash<QByteArray, QSqlQuery*> stmts;
+    QString error;
+
+    ~Connection()
+    {
+        qDeleteAll(stmts);
+        stmts.clear();
+        db.close();
+        db = QSqlDatabase();
+        QSqlDatabase::removeDatabase(name);
+    }
+};
+
+static const char *kSchema[] = {
+    "CREATE TABLE IF NOT EXISTS days ("
+    "  date INTEGER NOT NULL, kind INTEGER NOT NULL, budget REAL,"
+    "  PRIMARY KEY (date, kind)) WITHOUT ROWID",
+    "CREATE TABLE IF NOT EXISTS ledger ("
+    "  id INTEGER PRIMARY KEY, date INTEGER NOT NULL, pos INTEGER NOT NULL,"
+    "  type INTEGER NOT NULL, category TEXT NOT NULL, amount INTEGER NOT NULL, note TEXT NOT NULL,"
+    "  type_name TEXT)",
+    "CREATE INDEX IF NOT EXISTS ledger_date ON ledger (date)",
+    "CREATE INDEX IF NOT EXISTS ledger_category ON ledger (category, date)",
+    "CREATE TABLE IF NOT EXISTS todos ("
+    "  id INTEGER PRIMARY KEY, date INTEGER NOT NULL, pos INTEGER NOT NULL,"
+    "  title TEXT NOT NULL, all_day INTEGER NOT NULL, start TEXT, end TEXT, done INTEGER NOT NULL)",
+    "CREATE INDEX IF NOT EXISTS todos_date ON todos (date)",
+    "CREATE TABLE IF NOT EXISTS month_budget (month INTEGER PRIMARY KEY, budget REAL NOT NULL)",
+    "CREATE TABLE IF NOT EXISTS meta (key TEXT PRIMARY KEY, value TEXT)",
+};
+
+SqliteDayStore::SqliteDayStore(const QString &path, bool autoMigrate)
+    : m_path(path)
+{
+    QDir dir("data");
+    if (!dir.exists()) dir.mkpath(".");
+
+    if (!createSchema()) {
+        qWarning() << "storage: cannot open" << m_path << errorString();
+        return;
+    }
+
+    // ✅ 第一次用 sqlite：把原本的 JSON 搬進來（只搬一次，JSON 檔留著不刪）
+    if (autoMigrate && !isMigrated()) {
+        MigrationStats st;
+        if (migrateFromJson(false, &st))
+            qInfo().noquote() << QString("storage: migrated %1 ledger days, %2 todo days into %3")
+                                     .arg(st.ledgerDays).arg(st.todoDays).arg(m_path);
+        else
+            qWarning() << "storage: migration failed:" << errorString();
+    }
+}
+
+SqliteDayStore::~SqliteDayStore() = default;
+
+// ✅ 每條執行緒第一次用到時開自己的連線
+SqliteDayStore::Connection& SqliteDayStore::conn() const
+{
+    if (!m_conns.hasLocalData()) {
+        auto *c = new Connection;
+        c->name = QString("calendar-%1-%2").arg(quintptr(this), 0, 16)
+                                              .arg(quintptr(QThread::currentThreadId()), 0, 16);
+        c->db = QSqlDatabase::addDatabase("QSQLITE", c->name);
+        c->db.setDatabaseName(m_path);
+        c->db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+
+        if (!c->db.open()) {
+            c->error = c->db.lastError().text();
+        } else {
+            QSqlQuery q(c->db);
+            q.exec("PRAGMA journal_mode=WAL");
+            q.exec("PRAGMA synchronous=NORMAL");   // WAL 下只在 checkpoint 時 fsync
+        }
+        m_conns.setLocalData(c);
+    }
+    return *m_conns.localData();
+}
+
+QString SqliteDayStore::errorString() const
+{
+    return conn().error;
+}
+
+QSqlQuery& SqliteDayStore::stmt(const char *sql) const
+{
+    Connection &c = conn();
+    QSqlQuery *&q = c.stmts[QByteArray::fromRawData(sql, int(qstrlen(sql)))];
+    if (!q) {
+        q = new QSqlQuery(c.db);
+        if (!q->prepare(QString::fromLatin1(sql)))
+            c.error = q->lastError().text();
+    }
+    return *q;
+}
+
+bool SqliteDayStore::exec(QSqlQuery &q) const
+{
+    if (q.exec()) return true;
+    conn().error = q.lastError().text();
+    return false;
+}
+
+bool SqliteDayStore::begin()
+{
+    Connection &c = conn();
+    if (c.db.transaction()) return true;
+    c.error = c.db.lastError().text();
+    return false;
+}
+
+bool SqliteDayStore::commit()
+{
+    Connection &c = conn();
+    if (c.db.commit()) return true;
+    c.error = c.db.lastError().text();
+    c.db.rollback();
+    return false;
+}
+
+bool SqliteDayStore::createSchema()
+{
+    Connection &c = conn();
+    if (!c.db.isOpen()) return false;
+
+    QSqlQuery q(c.db);
+    for (const char *sql : kSchema) {
+        if (!q.exec(QString::fromLatin1(sql))) {
+            c.error = q.lastError().text();
+            return false;
+        }
+    }
+
+    // 舊資料庫沒有 type_name（不認得的 type 字串，見 AccountItem::typeName）就補上
+    bool hasTypeName = false;
+    if (!q.exec("PRAGMA table_info(ledger)")) {
+        c.error = q.lastError().text();
+        return false;
+    }
+    while (q.next())
+        if (q.value(1).toString() == "type_name") hasTypeName = true;
+    q.finish();
+    if (!hasTypeName && !q.exec("ALTER TABLE ledger ADD COLUMN type_name TEXT")) {
+        c.error = q.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+// ===== 讀寫一天 =====
+
+bool SqliteDayStore::loadLedger(const QDate &date, QVector<AccountItem> &items, bool &hasBudget, double &budget)
+{
+    items.clear();
+    hasBudget = false;
+    const qint64 julian = date.toJulianDay();
+
+    QSqlQuery &day = stmt("SELECT budget FROM days WHERE date = ? AND kind = 0");
+    day.bindValue(0, julian);
+    if (!exec(day) || !day.next()) return false;
+    if (!day.value(0).isNull()) {
+        hasBudget = true;
+        budget = day.value(0).toDouble();
+    }
+    day.finish();
+
+    QSqlQuery &q = stmt("SELECT type, category, amount, note, type_name FROM ledger WHERE date = ? ORDER BY pos");
+    q.bindValue(0, julian);
+    if (!exec(q)) return false;
+    while (q.next()) {
+        AccountItem item;
+        item.date = date;
+        item.type = EntryType(q.value(0).toInt());
+        item.setCategory(q.value(1).toString());
+        item.amount = q.value(2).toInt();
+        item.note = q.value(3).toString();
+        if (item.type == EntryType::Other) item.typeName = q.value(4).toString();
+        items.append(item);
+    }
+    q.finish();
+    return true;
+}
+
+bool SqliteDayStore::writeLedger(qint64 julian, const QVector<AccountItem> &items, const QVariant &budget)
+{
+    QSqlQuery &del = stmt("DELETE FROM ledger WHERE date = ?");
+    del.bindValue(0, julian);
+    if (!exec(del)) return false;
+
+    QSqlQuery &ins = stmt("INSERT INTO ledger (date, pos, type, category, amount, note, type_name)"
+                          " VALUES (?, ?, ?, ?, ?, ?, ?)");
+    for (int i = 0; i < items.size(); ++i) {
+        ins.bindValue(0, julian);
+        ins.bindValue(1, i);
+        ins.bindValue(2, int(items[i].type));
+        ins.bindValue(3, items[i].category());
+        ins.bindValue(4, items[i].amount);
+        ins.bindValue(5, items[i].note);
+        ins.bindValue(6, (items[i].type == EntryType::Other && !items[i].typeName.isEmpty())
+                             ? QVariant(items[i].typeName) : QVariant());
+        if (!exec(ins)) return false;
+    }
+
+    QSqlQuery &day = stmt("INSERT OR REPLACE INTO days (date, kind, budget) VALUES (?, 0, ?)");
+    day.bindValue(0, julian);
+    day.bindValue(1, budget);
+    return exec(day);
+}
+
+// 整天換掉（ops 是給 journal 的，這裡不需要）
+bool SqliteDayStore::saveLedger(const QDate &date, const QVector<AccountItem> &items, double budget,
+                                const QVector<QJsonObject> &)
+{
+    if (!begin()) return false;
+    if (!writeLedger(date.toJulianDay(), items, budget)) {
+        conn().db.rollback();
+        return false;
+    }
+    return commit();
+}
+
+bool SqliteDayStore::loadTodos(const QDate &date, QVector<Todo> &todos, QVector<bool> &done)
+{
+    todos.clear();
+    done.clear();
+    const qint64 julian = date.toJulianDay();
+
+    QSqlQuery &day = stmt("SELECT 1 FROM days WHERE date = ? AND kind = 1");
+    day.bindValue(0, julian);
+    if (!exec(day) || !day.next()) return false;
+    day.finish();
+
+    QSqlQuery &q = stmt("SELECT title, all_day, start, end, done FROM todos WHERE date = ? ORDER BY pos");
+    q.bindValue(0, julian);
+    if (!exec(q)) return false;
+    while (q.next()) {
+        Todo td;
+        td.title = q.value(0).toString();
+        td.allDay = q.value(1).toBool();
+        td.start = QDateTime::fromString(q.value(2).toString(), Qt::ISODate);
+        td.end = QDateTime::fromString(q.value(3).toString(), Qt::ISODate);
+        if (!td.start.isValid()) td.start = QDateTime(date, QTime(9,0));
+        if (!td.end.isValid())   td.end   = QDateTime(date, QTime(10,0));
+        todos.append(td);
+        done.append(q.value(4).toBool());
+    }
+    q.finish();
+    return true;
+}
+
+bool SqliteDayStore::writeTodos(qint64 julian, const QVector<Todo> &todos, const QVector<bool> &done)
+{
+    QSqlQuery &del = stmt("DELETE FROM todos WHERE date = ?");
+    del.bindValue(0, julian);
+    if (!exec(del)) return false;
+
+    QSqlQuery &ins = stmt("INSERT INTO todos (date, pos, title, all_day, start, end, done) VALUES (?, ?, ?, ?, ?, ?, ?)");
+    for (int i = 0; i < todos.size(); ++i) {
+        ins.bindValue(0, julian);
+        ins.bindValue(1, i);
+        ins.bindValue(2, todos[i].title);
+        ins.bindValue(3, todos[i].allDay);
+        ins.bindValue(4, todos[i].start.toString(Qt::ISODate));
+        ins.bindValue(5, todos[i].end.toString(Qt::ISODate));
+        ins.bindValue(6, i < done.size() && done[i]);
+        if (!exec(ins)) return false;
+    }
+
+    QSqlQuery &day = stmt("INSERT OR REPLACE INTO days (date, kind, budget) VALUES (?, 1, NULL)");
+    day.bindValue(0, julian);
+    return exec(day);
+}
+
+bool SqliteDayStore::saveTodos(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                               const QVector<QJsonObject> &)
+{
+    if (!begin()) return false;
+    if (!writeTodos(date.toJulianDay(), todos, done)) {
+        conn().db.rollback();
+        return false;
+    }
+    return commit();
+}
+
+bool SqliteDayStore::loadMonthBudget(int year, int month, double &budget)
+{
+    QSqlQuery &q = stmt("SELECT budget FROM month_budget WHERE month = ?");
+    q.bindValue(0, year * 100 + month);
+    if (!exec(q) || !q.next()) return false;
+    budget = q.value(0).toDouble();
+    q.finish();
+    return true;
+}
+
+bool SqliteDayStore::saveMonthBudget(int year, int month, double budget)
+{
+    QSqlQuery &q = stmt("INSERT OR REPLACE INTO month_budget (month, budget) VALUES (?, ?)");
+    q.bindValue(0, year * 100 + month);
+    q.bindValue(1, budget);
+    return exec(q);
+}
+
+// ===== 整段查詢：各一個走索引的查詢 =====
+
+QVector<QDate> SqliteDayStore::days(Kind kind) const
+{
+    QVector<QDate> out;
+    QSqlQuery &q = stmt("SELECT date FROM days WHERE kind = ? ORDER BY date");
+    q.bindValue(0, int(kind));
+    if (!exec(q)) return out;
+    while (q.next())
+        out.append(QDate::fromJulianDay(q.value(0).toLongLong()));
+    q.finish();
+    return out;
+}
+
+RangeTotals SqliteDayStore::aggregate(const QDate &from, const QDate &to) const
+{
+    RangeTotals out;
+    QSqlQuery &q = stmt("SELECT type, category, SUM(amount), COUNT(*) FROM ledger"
+                        " WHERE date BETWEEN ? AND ? GROUP BY type, category");
+    q.bindValue(0, from.toJulianDay());
+    q.bindValue(1, to.toJulianDay());
+    if (!exec(q)) return out;
+
+    while (q.next()) {
+        const EntryType type = EntryType(q.value(0).toInt());
+        const double sum = q.value(2).toDouble();
+        const int count = q.value(3).toInt();
+
+        CategoryTotal &c = out.categories[q.value(1).toString()];
+        if (type == EntryType::Income) {
+            out.income += sum;
+            c.income += sum;
+        } else if (type == EntryType::Expense) {
+            out.expense += sum;
+            c.expense += sum;
+        }
+        out.count += count;
+        c.count += count;
+    }
+    q.finish();
+    return out;
+}
+
+QMap<QDate, DayTotal> SqliteDayStore::dayTotals(const QDate &from, const QDate &to) const
+{
+    QMap<QDate, DayTotal> out;
+    QSqlQuery &q = stmt("SELECT date, type, SUM(amount), COUNT(*) FROM ledger"
+                        " WHERE date BETWEEN ? AND ? GROUP BY date, type");
+    q.bindValue(0, from.toJulianDay());
+    q.bindValue(1, to.toJulianDay());
+    if (!exec(q)) return out;
+
+    while (q.next()) {
+        DayTotal &t = out[QDate::fromJulianDay(q.value(0).toLongLong())];
+        const EntryType type = EntryType(q.value(1).toInt());
+        if (type == EntryType::Income) t.income += q.value(2).toDouble();
+        else if (type == EntryType::Expense) t.expense += q.value(2).toDouble();
+        t.count += q.value(3).toInt();
+    }
+    q.finish();
+    return out;
+}
+
+// ✅ 類別、備註、待辦標題的子字串查詢；一天一種（記帳 / 待辦）算一筆結果
+QVector<SearchHit> SqliteDayStore::search(const QString &query, int limit) const
+{
+    QVector<SearchHit> hits;
+    const QString needle = query.trimmed();
+    if (needle.isEmpty()) return hits;
+
+    QString pattern = needle;
+    pattern.replace('\\', "\\\\").replace('%', "\\%").replace('_', "\\_");
+    pattern = '%' + pattern + '%';
+
+    QSqlQuery &q = stmt("SELECT date, 0, category, note FROM ledger"
+                        " WHERE category LIKE ? ESCAPE '\\' OR note LIKE ? ESCAPE '\\'"
+                        " UNION ALL"
+                        " SELECT date, 1, title, '' FROM todos WHERE title LIKE ? ESCAPE '\\'");
+    for (int i = 0; i < 3; ++i)
+        q.bindValue(i, pattern);
+    if (!exec(q)) return hits;
+
+    QHash<qint64, int> at;   // (date, kind) -> hits 的位置
+    while (q.next()) {
+        const qint64 julian = q.value(0).toLongLong();
+        const bool todo = q.value(1).toInt() == 1;
+        const QString title = q.value(2).toString();
+        const QString note = q.value(3).toString();
+        const qint64 key = julian * 2 + (todo ? 1 : 0);
+
+        auto it = at.find(key);
+        if (it == at.end()) {
+            SearchHit h;
+            h.date = QDate::fromJulianDay(julian);
+            h.todo = todo;
+            h.snippet = note.isEmpty() ? title : title + " " + note;
+            it = at.insert(key, hits.size());
+            hits.append(h);
+        }
+        // 整個類別 / 標題就是關鍵字的排前面
+        hits[*it].score += (title.compare(needle, Qt::CaseInsensitive) == 0) ? 20 : 10;
+    }
+    q.finish();
+
+    std::sort(hits.begin(), hits.end(), [](const SearchHit &a, const SearchHit &b){
+        if (a.score != b.score) return a.score > b.score;
+        return a.date > b.date;
+    });
+    if (hits.size() > limit) hits.resize(limit);
+    return hits;
+}
+
+// ===== 從 JSON 搬過來 =====
+
+bool SqliteDayStore::isMigrated() const
+{
+    QSqlQuery &q = stmt("SELECT value FROM meta WHERE key = 'migrated'");
+    const bool done = exec(q) && q.next();
+    q.finish();
+    return done;
+}
+
+bool SqliteDayStore::migrateFromJson(bool force, MigrationStats *stats, const Progress &progress)
+{
+    if (!force && isMigrated()) return true;
+
+    // journal 裡還沒壓回日檔的先壓回去，之後只讀日檔
+    // （上一批有沒寫成功的日子時，第一輪先重試那些，第二輪才壓 journal.log）
+    if (QFile::exists("data/journal.log") || QFile::exists("data/journal.compacting")) {
+        Journal &j = Journal::instance();
+        for (int round = 0; round < 2; ++round) {
+            j.waitForCompaction();
+            if (j.pendingDates("ledger").isEmpty() && j.pendingDates("todo").isEmpty()) break;
+            j.compactAsync();
+        }
+        j.waitForCompaction();
+    }
+
+    JsonDayStore json;
+    const QVector<QDate> ledgerDays = json.days(Ledger);
+    const QVector<QDate> todoDays = json.days(Todos);
+    const QStringList budgetFiles = QDir("data").entryList(QStringList{"budget_????-??.json"}, QDir::Files);
+    const int total = ledgerDays.size() + todoDays.size() + budgetFiles.size();
+
+    MigrationStats st;
+    int done = 0;
+    auto tick = [&]{
+        ++done;
+        if (progress && (done % 256 == 0 || done == total)) progress(done, total);
+    };
+
+    if (!begin()) return false;
+    auto fail = [&]{
+        conn().db.rollback();
+        return false;
+    };
+
+    for (const QDate &d : ledgerDays) {
+        QVector<AccountItem> items;
+        bool hasBudget = false;
+        double budget = 0;
+        json.loadLedger(d, items, hasBudget, budget);
+        if (!writeLedger(d.toJulianDay(), items, hasBudget ? QVariant(budget) : QVariant()))
+            return fail();
+        st.ledgerDays++;
+        st.entries += items.size();
+        tick();
+    }
+
+    for (const QDate &d : todoDays) {
+        QVector<Todo> todos;
+        QVector<bool> doneFlags;
+        json.loadTodos(d, todos, doneFlags);
+        if (!writeTodos(d.toJulianDay(), todos, doneFlags))
+            return fail();
+        st.todoDays++;
+        st.todos += todos.size();
+        tick();
+    }
+
+    for (const QString &name : budgetFiles) {
+        const int year = name.mid(7, 4).toInt();
+        const int month = name.mid(12, 2).toInt();
+        double budget = 0;
+        if (year > 0 && month >= 1 && month <= 12 && json.loadMonthBudget(year, month, budget)) {
+            if (!saveMonthBudget(year, month, budget)) return fail();
+            st.budgets++;
+        }
+        tick();
+    }
+
+    QSqlQuery &meta = stmt("INSERT OR REPLACE INTO meta (key, value) VALUES ('migrated', ?)");
+    meta.bindValue(0, QDateTime::currentDateTime().toString(Qt::ISODate));
+    if (!exec(meta)) return fail();
+
+    if (!commit()) return false;
+    if (stats) *stats = st;
+    return true;
+}
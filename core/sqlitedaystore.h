@@ -0,0 +1,74 @@
+#pragma once
+#include <QString>
+#include <QThreadStorage>
+#include <QVariant>
+#include <functional>
+
+#include "daystore.h"
+
+class QSqlDatabase;
+class QSqlQuery;
+
+// ✅ QSQLITE 後端：data/calendar.db（WAL 模式）
+// ledger / todos 一筆一列，以 julian day 當日期欄，date 與 (category, date) 都有索引
+// 每條執行緒各自一個連線、各自一組 prepared statement；WAL 讓 GUI 讀與儲存執行緒寫互不擋
+// 第一次開啟時若 data/ 有 JSON 日檔，整批搬進來一次（meta.migrated 記錄已搬過）
+class SqliteDayStore : public DayStore
+{
+public:
+    // autoMigrate 為 false 時不自動搬，由呼叫端決定（calendar-cli migrate）
+    explicit SqliteDayStore(const QString &path, bool autoMigrate = true);
+    ~SqliteDayStore() override;
+
+    QString name() const override { return "sqlite"; }
+
+    bool loadLedger(const QDate &date, QVector<AccountItem> &items, bool &hasBudget, double &budget) override;
+    bool saveLedger(const QDate &date, const QVector<AccountItem> &items, double budget,
+                    const QVector<QJsonObject> &ops) override;
+    bool loadTodos(const QDate &date, QVector<Todo> &todos, QVector<bool> &done) override;
+    bool saveTodos(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                   const QVector<QJsonObject> &ops) override;
+
+    bool loadMonthBudget(int year, int month, double &budget) override;
+    bool saveMonthBudget(int year, int month, double budget) override;
+
+    QVector<QDate> days(Kind kind) const override;
+
+    bool indexed() const override { return true; }
+    RangeTotals aggregate(const QDate &from, const QDate &to) const override;
+    QMap<QDate, DayTotal> dayTotals(const QDate &from, const QDate &to) const override;
+    QVector<SearchHit> search(const QString &query, int limit) const override;
+
+    struct MigrationStats {
+        int ledgerDays = 0;
+        int todoDays = 0;
+        int entries = 0;
+        int todos = 0;
+        int budgets = 0;
+    };
+    using Progress = std::function<void(int done, int total)>;
+
+    // 把 data/ 的 JSON（含 journal）整批搬進資料庫，單一交易；force 才會重搬
+    bool migrateFromJson(bool force, MigrationStats *stats = nullptr, const Progress &progress = {});
+    bool isMigrated() const;
+
+    // 這條執行緒上一次失敗的原因
+    QString errorString() const;
+
+private:
+    struct Connection;
+
+    Connection& conn() const;
+    QSqlQuery& stmt(const char *sql) const;     // 這條執行緒上 prepare 過就重用
+    bool createSchema();
+    bool exec(QSqlQuery &q) const;
+    bool begin();
+    bool commit();
+
+    // 呼叫端負責交易；budget 為 null 表示那天沒有記錄預算
+    bool writeLedger(qint64 julian, const QVector<AccountItem> &items, const QVariant &budget);
+    bool writeTodos(qint64 julian, const QVector<Todo> &todos, const QVector<bool> &done);
+
+    QString m_path;
+    mutable QThreadStorage<Connection*> m_conns;
+};
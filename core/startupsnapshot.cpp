@@ -0,0 +1,134 @@
+#include "startupsnapshot.h"
+#include "todostore.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+static const int kVersion = 1;
+
+QString StartupSnapshot::filePath()
+{
+    return "data/cache/startup.json";
+}
+
+// 日檔、摘要、週期規則都以 QSaveFile 改名寫入，會動到 data/ 的修改時間；
+// 原地寫入的（journal、sqlite、外部編輯器改今天的檔）另外列出
+// 快照放在 data/cache/，自己寫入不會改到 data/
+QHash<QString, qint64> StartupSnapshot::sourceTimes(const QDate &date)
+{
+    const QString day = date.toString("yyyy-MM-dd");
+    const QString month = date.toString("yyyy-MM");
+    const QStringList paths = {
+        "data",
+        "data/journal.log",
+        "data/calendar.db",
+        "data/calendar.db-wal",
+        "data/recurring.json",
+        QString("data/%1.json").arg(day),
+        QString("data/%1.todo.json").arg(day),
+        QString("data/budget_%1.json").arg(month),
+        QString("data/summary_%1.json").arg(month),
+    };
+
+    QHash<QString, qint64> times;
+    for (const QString &p : paths) {
+        const QFileInfo fi(p);
+        times.insert(p, fi.exists() ? fi.lastModified().toMSecsSinceEpoch() : -1);
+    }
+    return times;
+}
+
+bool StartupSnapshot::save() const
+{
+    if (!date.isValid()) return false;
+
+    // 先建好 data/cache，再量修改時間
+    QDir("data").mkpath("cache");
+
+    QJsonObject root;
+    root["version"] = kVersion;
+    root["date"] = date.toString(Qt::ISODate);
+    root["storage"] = QString::fromLocal8Bit(qgetenv("CALENDAR_STORAGE"));
+
+    QJsonObject sources;
+    const auto times = sourceTimes(date);
+    for (auto it = times.constBegin(); it != times.constEnd(); ++it)
+        sources[it.key()] = double(it.value());
+    root["sources"] = sources;
+
+    QJsonArray account;
+    for (const AccountItem &item : items)
+        account.append(Account::itemToJson(item));
+    root["account"] = account;
+    if (hasBudget) root["monthly_budget"] = monthlyBudget;
+
+    QJsonArray todoArr;
+    for (int i = 0; i < todos.size(); ++i)
+        todoArr.append(TodoStore::toJson(todos[i], i < todoDone.size() && todoDone[i]));
+    root["todos"] = todoArr;
+
+    QJsonArray days;
+    for (const QDate &d : marks)
+        days.append(d.day());
+    root["marks"] = days;
+
+    if (hasTotals) {
+        root["income"] = monthIncome;
+        root["expense"] = monthExpense;
+    }
+
+    QSaveFile f(filePath());
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return f.commit();
+}
+
+bool StartupSnapshot::load(const QDate &today, StartupSnapshot &out)
+{
+    QFile f(filePath());
+    if (!f.open(QIODevice::ReadOnly)) return false;
+    const QJsonObject root = QJsonDocument::fromJson(f.readAll()).object();
+    f.close();
+
+    if (root["version"].toInt() != kVersion) return false;
+    if (QDate::fromString(root["date"].toString(), Qt::ISODate) != today) return false;
+    if (root["storage"].toString() != QString::fromLocal8Bit(qgetenv("CALENDAR_STORAGE"))) return false;
+
+    const QJsonObject sources = root["sources"].toObject();
+    const auto times = sourceTimes(today);
+    if (sources.size() != times.size()) return false;
+    for (auto it = times.constBegin(); it != times.constEnd(); ++it)
+        if (qint64(sources[it.key()].toDouble(-2)) != it.value()) return false;
+
+    StartupSnapshot s;
+    s.date = today;
+
+    for (const auto &v : root["account"].toArray())
+        s.items.append(Account::itemFromJson(v.toObject(), today));
+    s.hasBudget = root.contains("monthly_budget");
+    s.monthlyBudget = root["monthly_budget"].toDouble();
+
+    for (const auto &v : root["todos"].toArray()) {
+        bool d = false;
+        s.todos.append(TodoStore::fromJson(v.toObject(), today, &d));
+        s.todoDone.append(d);
+    }
+
+    for (const auto &v : root["marks"].toArray()) {
+        const QDate d(today.year(), today.month(), v.toInt());
+        if (d.isValid()) s.marks.append(d);
+    }
+
+    s.hasTotals = root.contains("income");
+    s.monthIncome = root["income"].toDouble();
+    s.monthExpense = root["expense"].toDouble();
+
+    out = s;
+    return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <QDate>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "account.h"
+#include "models.h"
+
+// ✅ 暖啟動快照：data/cache/startup.json
+// 離開時記下今天的記帳 / 待辦、這個月的白點與收支，連同來源檔的修改時間；
+// 下次開啟時來源都沒變才拿來先畫第一個畫面，真正的資料照樣在背景讀
+struct StartupSnapshot {
+    QDate date;                 // 快照的那天（只在同一天開啟時有效）
+
+    QVector<AccountItem> items;
+    bool hasBudget = false;
+    double monthlyBudget = 0;
+
+    QVector<Todo> todos;
+    QVector<bool> todoDone;
+
+    QVector<QDate> marks;       // date 那個月有白點的日子
+
+    bool hasTotals = false;     // 月統計回來過才有
+    double monthIncome = 0;
+    double monthExpense = 0;
+
+    bool isValid() const { return date.isValid(); }
+
+    // 要在所有存檔（含 journal 壓縮）都寫完之後呼叫，修改時間才會對
+    bool save() const;
+    // 來源檔有任何一個變了（或不是同一天、換了儲存方式）就回傳 false
+    static bool load(const QDate &today, StartupSnapshot &out);
+
+    static QString filePath();
+
+private:
+    // 會影響快照內容的檔案 -> 修改時間（ms，不存在為 -1）
+    static QHash<QString, qint64> sourceTimes(const QDate &date);
+};
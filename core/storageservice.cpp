@@ -0,0 +1,280 @@
+#include "storageservice.h"
+#include "todostore.h"
+#include "writebehind.h"
+#include "balanceindex.h"
+#include "todointervals.h"
+#include "daystore.h"
+
+#include <QTimer>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <QDebug>
+
+// 最後一次修改後多久寫出
+static const int kDebounceMs = 400;
+// 積了這麼多天沒寫就立刻寫出，關閉時要寫的量因此有上限
+static const int kMaxDirtyDays = 32;
+static const int kShutdownFlushMs = 2000;
+
+StorageService::StorageService(QObject *parent)
+    : QObject(parent)
+{
+    m_thread.setObjectName("storage");
+
+    m_ctx = new QObject;
+    m_ctx->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_ctx, &QObject::deleteLater);
+
+    m_writer = new WriteBehind(
+        [=](const QDate &date, bool ok){ deliver([=]{ emit ledgerSaved(date, ok); }); },
+        [=](const QDate &date, bool ok){ deliver([=]{ emit todosSaved(date, ok); }); });
+
+    m_thread.start();
+
+    // 計時器要在工作執行緒上建立
+    post([=]{
+        m_flushTimer = new QTimer(m_ctx);
+        m_flushTimer->setSingleShot(true);
+        m_flushTimer->setInterval(kDebounceMs);
+        connect(m_flushTimer, &QTimer::timeout, m_ctx, [=]{ m_writer->flushAll(); });
+    });
+}
+
+StorageService::~StorageService()
+{
+    if (!flush(kShutdownFlushMs))
+        qWarning() << "storage: flush did not finish within" << kShutdownFlushMs << "ms, waiting";
+
+    quint64 req = writesRequested();
+    quint64 done = writesPerformed();
+    qInfo().noquote() << QString("storage: %1 saves -> %2 writes (%3 coalesced)")
+                             .arg(req).arg(done).arg(req - done);
+
+    m_thread.quit();
+    m_thread.wait();
+    delete m_writer;
+
+    // 工作執行緒已停，搜尋索引有變就寫回
+    SearchIndex::instance().save();
+}
+
+bool StorageService::flush(int timeoutMs)
+{
+    QSharedPointer<QSemaphore> done(new QSemaphore);
+    post([=]{
+        if (m_flushTimer) m_flushTimer->stop();
+        m_writer->flushAll();
+        done->release();
+    });
+    return done->tryAcquire(1, timeoutMs);
+}
+
+quint64 StorageService::writesRequested() const
+{
+    return m_writer->requested();
+}
+
+quint64 StorageService::writesPerformed() const
+{
+    return m_writer->written();
+}
+
+void StorageService::scheduleFlush()
+{
+    if (m_writer->dirtyCount() >= kMaxDirtyDays) {
+        if (m_flushTimer) m_flushTimer->stop();
+        m_writer->flushAll();
+        return;
+    }
+    if (m_flushTimer) m_flushTimer->start();   // 重新計時
+}
+
+void StorageService::post(std::function<void()> job)
+{
+    QMetaObject::invokeMethod(m_ctx, std::move(job), Qt::QueuedConnection);
+}
+
+void StorageService::deliver(std::function<void()> fn)
+{
+    QMetaObject::invokeMethod(this, std::move(fn), Qt::QueuedConnection);
+}
+
+void StorageService::requestDay(const QDate &date, double carryBudget)
+{
+    const int id = ++m_dayGen;
+    m_latestDay.storeRelease(id);
+
+    post([=]{
+        if (m_latestDay.loadAcquire() != id) return;   // 使用者已經點了別天
+
+        // 還在延遲寫入中的那天，以記憶體裡的最新內容為準
+        Account account;
+        account.setMonthlyBudget(carryBudget);
+        if (!m_writer->ledger(date, account))
+            account.loadFromFile(date);
+
+        QVector<Todo> todos;
+        QVector<bool> done;
+        if (!m_writer->todos(date, todos, done))
+            TodoStore::load(date, todos, done);
+
+        deliver([=]{
+            if (m_latestDay.loadAcquire() != id) return;
+            emit dayLoaded(date, account, todos, done);
+        });
+    });
+}
+
+void StorageService::requestMonth(int year, int month)
+{
+    const int id = ++m_monthGen;
+    m_latestMonth.storeRelease(id);
+
+    post([=]{
+        if (m_latestMonth.loadAcquire() != id) return;
+
+        m_writer->flushLedgerMonth(year, month);
+        RangeTotals totals = LedgerQuery::month(year, month);
+
+        deliver([=]{
+            if (m_latestMonth.loadAcquire() != id) return;
+            emit monthLoaded(year, month, totals);
+        });
+    });
+}
+
+void StorageService::prefetchMonths(int year, int month, int epoch)
+{
+    const int id = ++m_prefetchGen;
+    m_latestPrefetch.storeRelease(id);
+
+    // 各排一個工作：先跑的那個月做完，另一個仍可被取消
+    const QDate shown(year, month, 1);
+    for (const QDate &m : { shown.addMonths(1), shown.addMonths(-1) }) {
+        post([=]{
+            if (m_latestPrefetch.loadAcquire() != id) return;   // 已經又翻頁了
+
+            m_writer->flushLedgerMonth(m.year(), m.month());
+            MonthPrefetch data;
+            data.totals = LedgerQuery::month(m.year(), m.month());
+            data.recurringDates = RecurrenceStore::instance().datesIn(m, m.addMonths(1).addDays(-1));
+
+            deliver([=]{ emit monthPrefetched(m.year(), m.month(), epoch, data); });
+        });
+    }
+}
+
+void StorageService::requestYear(int year)
+{
+    post([=]{
+        for (int m = 1; m <= 12; ++m)
+            m_writer->flushLedgerMonth(year, m);
+        DailyTotals totals = DailyTotals::load(year);
+
+        deliver([=]{ emit yearLoaded(year, totals); });
+    });
+}
+
+void StorageService::requestBalanceIndex()
+{
+    post([=]{
+        if (!BalanceIndex::instance().isReady()) {
+            m_writer->flushAll();   // 月摘要要先反映延遲中的存檔
+            BalanceIndex::instance().build();
+        }
+        deliver([=]{ emit balanceIndexReady(); });
+    });
+}
+
+void StorageService::requestTodoIndex()
+{
+    post([=]{
+        if (TodoIntervals::instance().isReady()) return;
+        m_writer->flushAll();   // 延遲中的待辦先寫出，建的時候才讀得到
+        TodoIntervals::instance().build();
+    });
+}
+
+void StorageService::requestSearch(const QString &query)
+{
+    const int id = ++m_searchGen;
+    m_latestSearch.storeRelease(id);
+
+    post([=]{
+        if (m_latestSearch.loadAcquire() != id) return;   // 使用者還在打字
+
+        // 有索引的後端直接查資料庫；延遲寫入的先寫下去
+        QVector<SearchHit> hits;
+        DayStore &store = DayStore::instance();
+        if (store.indexed()) {
+            m_writer->flushAll();
+            hits = store.search(query, 100);
+        } else {
+            SearchIndex &index = SearchIndex::instance();
+            if (!index.isOpen()) {
+                m_writer->flushAll();
+                index.open();
+            }
+            hits = index.search(query);
+        }
+
+        deliver([=]{
+            if (m_latestSearch.loadAcquire() != id) return;
+            emit searchResults(query, hits);
+        });
+    });
+}
+
+void StorageService::saveLedger(const QDate &date, const Account &account)
+{
+    post([=]{
+        m_writer->putLedger(date, account);
+        scheduleFlush();
+    });
+}
+
+void StorageService::saveTodos(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                               const QVector<QJsonObject> &ops)
+{
+    post([=]{
+        m_writer->putTodos(date, todos, done, ops);
+        scheduleFlush();
+    });
+}
+
+void StorageService::saveRecurring()
+{
+    // 規則變了，累計餘額裡展開的週期收支已經不對；下次開走勢圖時重建
+    BalanceIndex::instance().invalidate();
+    const bool ok = RecurrenceStore::instance().save();
+    deliver([=]{ emit recurringSaved(ok); });
+}
+
+void StorageService::addRecurring(const RecurrenceRule &rule)
+{
+    post([=]{
+        RecurrenceStore::instance().add(rule);
+        saveRecurring();
+    });
+}
+
+void StorageService::skipRecurring(const QString &id, const QDate &date)
+{
+    post([=]{
+        if (RecurrenceStore::instance().skip(id, date)) saveRecurring();
+    });
+}
+
+void StorageService::removeRecurring(const QString &id)
+{
+    post([=]{
+        if (RecurrenceStore::instance().remove(id)) saveRecurring();
+    });
+}
+
+void StorageService::setRecurringDone(const QString &id, const QDate &date, bool done)
+{
+    post([=]{
+        if (RecurrenceStore::instance().setDone(id, date, done)) saveRecurring();
+    });
+}
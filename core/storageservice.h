@@ -0,0 +1,101 @@
+#pragma once
+#include <QObject>
+#include <QThread>
+#include <QAtomicInt>
+#include <QDate>
+#include <QSet>
+#include <QJsonObject>
+#include <QVector>
+#include <functional>
+
+class QTimer;
+class WriteBehind;
+
+#include "account.h"
+#include "ledgerquery.h"
+#include "dailytotals.h"
+#include "searchindex.h"
+#include "recurrence.h"
+#include "models.h"
+
+// 預先讀好的一個月：收支統計與週期規則落在這個月的日子
+struct MonthPrefetch {
+    RangeTotals totals;
+    QSet<QDate> recurringDates;
+};
+
+// ✅ 背景儲存服務：所有記帳 / 待辦讀寫與月統計都在一條工作執行緒上跑
+// 結果以 signal 送回 GUI；同一條佇列依序執行，所以同一天的存檔不會亂序
+// 存檔先進延遲寫入（WriteBehind），短時間內的連續修改合併成一次寫檔
+class StorageService : public QObject
+{
+    Q_OBJECT
+public:
+    explicit StorageService(QObject *parent = nullptr);
+    ~StorageService() override;
+
+    // 讀一天；較舊、還沒跑的讀取會被取消
+    // carryBudget：那天沒有記錄預算時沿用的值（與原本同一個 Account 連續讀檔的行為一致）
+    void requestDay(const QDate &date, double carryBudget);
+    void requestMonth(int year, int month);
+    // 翻頁後預讀前後兩個月；再翻頁時，還沒跑的舊預讀會被取消
+    // epoch 原封不動跟著 monthPrefetched 回來，呼叫端用來判斷結果是否已過期
+    void prefetchMonths(int year, int month, int epoch);
+    // 一整年的每日收支（熱度圖 / 年度總覽）；不取消，每年各自回來
+    void requestYear(int year);
+    // 累計餘額索引第一次用到時才建（建好後 Account::saveToFile 會自己維護）
+    void requestBalanceIndex();
+    // 全文搜尋；第一次會先開啟（或建立）索引。較舊、還沒跑的查詢會被取消
+    void requestSearch(const QString &query);
+    // 待辦區間樹：啟動後排在第一天的讀取之後建，新增待辦時拿來查衝突與空檔
+    void requestTodoIndex();
+
+    void saveLedger(const QDate &date, const Account &account);
+    void saveTodos(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                   const QVector<QJsonObject> &ops);
+
+    // 週期規則：在工作執行緒上改 RecurrenceStore 再寫 data/recurring.json
+    // 與月統計同一條佇列，之後要的統計一定看得到這次的變動
+    void addRecurring(const RecurrenceRule &rule);
+    void skipRecurring(const QString &id, const QDate &date);
+    void removeRecurring(const QString &id);
+    void setRecurringDone(const QString &id, const QDate &date, bool done);
+
+    // 把延遲中的寫入全部寫出；最多等 timeoutMs，逾時回傳 false（寫入仍會在背景完成）
+    bool flush(int timeoutMs);
+
+    quint64 writesRequested() const;
+    quint64 writesPerformed() const;
+
+signals:
+    void dayLoaded(const QDate &date, const Account &account,
+                   const QVector<Todo> &todos, const QVector<bool> &done);
+    void monthLoaded(int year, int month, const RangeTotals &totals);
+    void monthPrefetched(int year, int month, int epoch, const MonthPrefetch &data);
+    void yearLoaded(int year, const DailyTotals &totals);
+    void balanceIndexReady();
+    void searchResults(const QString &query, const QVector<SearchHit> &hits);
+    void ledgerSaved(const QDate &date, bool ok);
+    void todosSaved(const QDate &date, bool ok);
+    void recurringSaved(bool ok);
+
+private:
+    void post(std::function<void()> job);
+    void deliver(std::function<void()> fn);
+    void scheduleFlush();   // 工作執行緒上呼叫
+    void saveRecurring();   // 工作執行緒上呼叫
+
+    QThread m_thread;
+    QObject *m_ctx = nullptr;   // 住在工作執行緒上，用來排工作
+    WriteBehind *m_writer = nullptr;
+    QTimer *m_flushTimer = nullptr;
+
+    QAtomicInt m_latestDay;
+    QAtomicInt m_latestMonth;
+    int m_dayGen = 0;
+    int m_monthGen = 0;
+    QAtomicInt m_latestPrefetch;
+    int m_prefetchGen = 0;
+    QAtomicInt m_latestSearch;
+    int m_searchGen = 0;
+};
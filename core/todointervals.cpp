@@ -0,0 +1,205 @@
+#include "todointervals.h"
+#include "daystore.h"
+#include "recurrence.h"
+
+#include <algorithm>
+#include <limits>
+
+TodoIntervals& TodoIntervals::instance()
+{
+    static TodoIntervals idx;
+    return idx;
+}
+
+bool TodoIntervals::isValidRange(const Todo &td)
+{
+    if (td.allDay) return true;
+    return td.start.isValid() && td.end.isValid() && td.end >= td.start;
+}
+
+bool TodoIntervals::overlaps(const TodoSpan &s, const QDateTime &from, const QDateTime &to)
+{
+    const QDateTime end = (s.end > s.start) ? s.end : s.start.addMSecs(1);
+    return s.start < to && end > from;
+}
+
+bool TodoIntervals::isReady() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_ready;
+}
+
+void TodoIntervals::build()
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_ready) return;
+        m_building = true;
+    }
+
+    // 只列一次有待辦的日子；journal 模式讀的時候會重播日誌
+    DayStore &store = DayStore::instance();
+    const QVector<QDate> dates = store.days(DayStore::Todos);
+
+    QVector<QPair<qint64, QVector<Todo>>> days;
+    days.reserve(dates.size());
+    for (const QDate &date : dates) {
+        QVector<Todo> todos;
+        QVector<bool> done;
+        store.loadTodos(date, todos, done);
+        days.append({ date.toJulianDay(), todos });
+    }
+
+    QMutexLocker lock(&m_mutex);
+    m_entries.clear();
+    for (const auto &d : days)
+        for (const Todo &td : d.second)
+            if (!td.allDay && isValidRange(td))
+                m_entries.append({ td.start.toMSecsSinceEpoch(),
+                                   qMax(td.end.toMSecsSinceEpoch(), td.start.toMSecsSinceEpoch() + 1),
+                                   d.first, td.title });
+    std::sort(m_entries.begin(), m_entries.end(), [](const Entry &a, const Entry &b){
+        return a.start < b.start;
+    });
+
+    // 建樹期間存過檔的日子
+    for (auto it = m_pending.constBegin(); it != m_pending.constEnd(); ++it)
+        insertDay(it.key(), it.value());
+    m_pending.clear();
+
+    m_dirty = true;
+    m_building = false;
+    m_ready = true;
+}
+
+void TodoIntervals::setDay(const QDate &date, const QVector<Todo> &todos)
+{
+    QMutexLocker lock(&m_mutex);
+    if (m_building) {
+        m_pending.insert(date.toJulianDay(), todos);
+        return;
+    }
+    if (!m_ready) return;
+    insertDay(date.toJulianDay(), todos);
+}
+
+// 一天通常只有幾筆：整天拿掉再依序插回，O(n) 搬移，n 上萬也遠低於 1 ms
+void TodoIntervals::insertDay(qint64 julian, const QVector<Todo> &todos)
+{
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                   [=](const Entry &e){ return e.julian == julian; }),
+                    m_entries.end());
+
+    for (const Todo &td : todos) {
+        if (td.allDay || !isValidRange(td)) continue;
+        Entry e{ td.start.toMSecsSinceEpoch(),
+                 qMax(td.end.toMSecsSinceEpoch(), td.start.toMSecsSinceEpoch() + 1),
+                 julian, td.title };
+        auto at = std::upper_bound(m_entries.begin(), m_entries.end(), e.start,
+                                   [](qint64 s, const Entry &x){ return s < x.start; });
+        m_entries.insert(at, e);
+    }
+    m_dirty = true;
+}
+
+qint64 TodoIntervals::fillMaxEnd(int lo, int hi) const
+{
+    if (lo >= hi) return std::numeric_limits<qint64>::min();
+    const int mid = lo + (hi - lo) / 2;
+    const qint64 m = qMax(m_entries[mid].end, qMax(fillMaxEnd(lo, mid), fillMaxEnd(mid + 1, hi)));
+    m_maxEnd[mid] = m;
+    return m;
+}
+
+void TodoIntervals::ensureMaxEnd() const
+{
+    if (!m_dirty) return;
+    m_maxEnd.resize(m_entries.size());
+    fillMaxEnd(0, m_entries.size());
+    m_dirty = false;
+}
+
+void TodoIntervals::collect(int lo, int hi, qint64 from, qint64 to, QVector<TodoSpan> &out) const
+{
+    if (lo >= hi) return;
+    const int mid = lo + (hi - lo) / 2;
+    if (m_maxEnd[mid] <= from) return;   // 整棵子樹都在 from 之前結束
+
+    collect(lo, mid, from, to, out);
+
+    const Entry &e = m_entries[mid];
+    if (e.start >= to) return;           // 右子樹開始得更晚
+    if (e.end > from) {
+        TodoSpan s;
+        s.start = QDateTime::fromMSecsSinceEpoch(e.start);
+        s.end = QDateTime::fromMSecsSinceEpoch(e.end);
+        s.day = QDate::fromJulianDay(e.julian);
+        s.title = e.title;
+        out.append(s);
+    }
+    collect(mid + 1, hi, from, to, out);
+}
+
+QVector<TodoSpan> TodoIntervals::overlapping(const QDateTime &from, const QDateTime &to) const
+{
+    QVector<TodoSpan> out;
+    if (!from.isValid() || !to.isValid() || to <= from) return out;
+
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_ready) {
+            ensureMaxEnd();
+            collect(0, m_entries.size(), from.toMSecsSinceEpoch(), to.toMSecsSinceEpoch(), out);
+        }
+    }
+
+    // 週期待辦：只展開查詢範圍（前一天起，跨夜的也算得到）
+    const QDate last = to.addMSecs(-1).date();
+    for (QDate d = from.date().addDays(-1); d <= last; d = d.addDays(1)) {
+        for (const RecurringTodo &r : RecurrenceStore::instance().todosOn(d)) {
+            if (r.todo.allDay || !isValidRange(r.todo)) continue;
+            TodoSpan s{ r.todo.start, r.todo.end, d, r.todo.title, true };
+            if (overlaps(s, from, to)) out.append(s);
+        }
+    }
+
+    std::stable_sort(out.begin(), out.end(), [](const TodoSpan &a, const TodoSpan &b){
+        return a.start < b.start;
+    });
+    return out;
+}
+
+// ✅ 忙碌時段依開始時間走一遍，每天的工作時段裡找夠長的縫
+QVector<TimeSlot> TodoIntervals::freeSlots(const QDateTime &from, const QDateTime &to, int minutes,
+                                           const QTime &dayStart, const QTime &dayEnd, int limit) const
+{
+    return freeSlotsIn(overlapping(from, to), from, to, minutes, dayStart, dayEnd, limit);
+}
+
+QVector<TimeSlot> TodoIntervals::freeSlotsIn(const QVector<TodoSpan> &busy, const QDateTime &from, const QDateTime &to,
+                                             int minutes, const QTime &dayStart, const QTime &dayEnd, int limit)
+{
+    QVector<TimeSlot> found;
+    if (minutes <= 0 || limit <= 0) return found;
+
+    const qint64 need = qint64(minutes) * 60 * 1000;
+    int b = 0;
+
+    for (QDate d = from.date(); d <= to.date() && found.size() < limit; d = d.addDays(1)) {
+        QDateTime cursor = qMax(from, QDateTime(d, dayStart));
+        const QDateTime close = qMin(to, QDateTime(d, dayEnd));
+
+        // 已經在這天之前結束的不必再看
+        while (b < busy.size() && busy[b].end <= cursor) ++b;
+
+        for (int i = b; i < busy.size() && cursor < close && found.size() < limit; ++i) {
+            if (busy[i].start >= close) break;
+            if (cursor.msecsTo(busy[i].start) >= need)
+                found.append({ cursor, cursor.addMSecs(need) });
+            cursor = qMax(cursor, busy[i].end);
+        }
+        if (found.size() < limit && cursor < close && cursor.msecsTo(close) >= need)
+            found.append({ cursor, cursor.addMSecs(need) });
+    }
+    return found;
+}
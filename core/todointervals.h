@@ -0,0 +1,79 @@
+#pragma once
+#include <QDate>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QTime>
+#include <QVector>
+
+#include "models.h"
+
+struct TodoSpan {
+    QDateTime start;
+    QDateTime end;
+    QDate day;              // 存在哪一天的日檔（週期待辦：展開的那天）
+    QString title;
+    bool recurring = false;
+};
+
+struct TimeSlot {
+    QDateTime start;
+    QDateTime end;
+};
+
+// ✅ 全部有時段的待辦放進一棵區間樹：依開始時間排序的陣列，
+// 隱含的平衡二元樹每個節點記子樹最大結束時間，重疊查詢 O(log n + k)
+// 全天待辦不佔時段、結束早於開始的不進樹；週期待辦查詢時才展開該時段
+class TodoIntervals
+{
+public:
+    static TodoIntervals& instance();
+
+    // 讀 data/ 的待辦日檔建樹；在背景執行緒呼叫
+    void build();
+    bool isReady() const;
+
+    // TodoStore::save 之後呼叫：整天換掉（還沒開始建就不必記，建的時候會讀到）
+    void setDay(const QDate &date, const QVector<Todo> &todos);
+
+    // 與 [from, to) 重疊的待辦，依開始時間排序
+    QVector<TodoSpan> overlapping(const QDateTime &from, const QDateTime &to) const;
+
+    // [from, to) 內每天 dayStart～dayEnd 之間、至少 minutes 分鐘的空檔，最多 limit 個
+    QVector<TimeSlot> freeSlots(const QDateTime &from, const QDateTime &to, int minutes,
+                                const QTime &dayStart = QTime(9, 0), const QTime &dayEnd = QTime(18, 0),
+                                int limit = 5) const;
+    // 同上，忙碌時段由呼叫端給（依開始時間排序）
+    static QVector<TimeSlot> freeSlotsIn(const QVector<TodoSpan> &busy, const QDateTime &from, const QDateTime &to,
+                                         int minutes, const QTime &dayStart, const QTime &dayEnd, int limit);
+
+    // 全天或結束不早於開始
+    static bool isValidRange(const Todo &td);
+
+    // 沒建好索引或還在延遲寫入的那天，呼叫端拿記憶體裡的待辦自己比
+    static bool overlaps(const TodoSpan &s, const QDateTime &from, const QDateTime &to);
+
+private:
+    TodoIntervals() = default;
+
+    struct Entry {
+        qint64 start;       // ms since epoch
+        qint64 end;         // 不含；長度 0 的當成 1 ms
+        qint64 julian;
+        QString title;
+    };
+
+    void insertDay(qint64 julian, const QVector<Todo> &todos);
+    void ensureMaxEnd() const;
+    qint64 fillMaxEnd(int lo, int hi) const;
+    void collect(int lo, int hi, qint64 from, qint64 to, QVector<TodoSpan> &out) const;
+
+    mutable QMutex m_mutex;
+    bool m_ready = false;
+    bool m_building = false;
+    QVector<Entry> m_entries;           // 依 start 排序
+    mutable QVector<qint64> m_maxEnd;   // 子樹 [lo, hi) 的最大 end，存在 mid
+    mutable bool m_dirty = false;       // 有增刪，查詢前重算 m_maxEnd
+    QHash<qint64, QVector<Todo>> m_pending;
+};
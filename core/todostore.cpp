@@ -0,0 +1,123 @@
+#include "todostore.h"
+#include "daycache.h"
+#include "daystore.h"
+#include "searchindex.h"
+#include "todointervals.h"
+#include "trace.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonArray>
+
+QString TodoStore::filePath(const QDate &date)
+{
+    QDir dir("data");
+    if (!dir.exists()) dir.mkpath(".");
+    return QString("data/%1.todo.json").arg(date.toString("yyyy-MM-dd"));
+}
+
+QJsonObject TodoStore::toJson(const Todo &td, bool done)
+{
+    QJsonObject o;
+    o["title"] = td.title;
+    o["allDay"] = td.allDay;
+    o["start"] = td.start.toString(Qt::ISODate);
+    o["end"]   = td.end.toString(Qt::ISODate);
+    o["done"]  = done;
+    return o;
+}
+
+Todo TodoStore::fromJson(const QJsonObject &o, const QDate &date, bool *done)
+{
+    Todo td;
+    td.title = o["title"].toString();
+    td.allDay = o["allDay"].toBool(true);
+    td.start = QDateTime::fromString(o["start"].toString(), Qt::ISODate);
+    td.end   = QDateTime::fromString(o["end"].toString(), Qt::ISODate);
+
+    if (!td.start.isValid()) td.start = QDateTime(date, QTime(9,0));
+    if (!td.end.isValid())   td.end   = QDateTime(date, QTime(10,0));
+
+    if (done) *done = o["done"].toBool(false);
+    return td;
+}
+
+bool TodoStore::load(const QDate &date, QVector<Todo> &todos, QVector<bool> &done)
+{
+    TRACE_SCOPE("TodoStore::load");
+    // ✅ 與記帳共用的日快取
+    DayCache &cache = DayCache::instance();
+    DayRecord r;
+    if (cache.todos(date, r)) {
+        todos = r.todos;
+        done = r.todoDone;
+        return r.todosExists;
+    }
+
+    bool exists = DayStore::instance().loadTodos(date, todos, done);
+
+    cache.putTodos(date, exists, todos, done);
+    return exists;
+}
+
+bool TodoStore::save(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                     const QVector<QJsonObject> &ops)
+{
+    TRACE_SCOPE("TodoStore::save");
+    if (!DayStore::instance().saveTodos(date, todos, done, ops)) return false;
+
+    DayCache::instance().putTodos(date, true, todos, done);
+    SearchIndex::instance().updateTodos(date, todos);
+    TodoIntervals::instance().setDay(date, todos);
+    return true;
+}
+
+bool TodoStore::readDayFile(const QDate &date, QVector<Todo> &todos, QVector<bool> &done,
+                            QString *journalBatch)
+{
+    todos.clear();
+    done.clear();
+    if (journalBatch) journalBatch->clear();
+
+    QFile f(filePath(date));
+    if (!f.open(QIODevice::ReadOnly)) return false;
+
+    const QByteArray data = f.readAll();
+    f.close();
+    TRACE_COUNT("file.opens", 1);
+    TRACE_COUNT("file.bytesRead", data.size());
+    TRACE_SCOPE_CAT("parse.todoDay", "parse");
+
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+
+    QJsonArray arr = doc.object()["todos"].toArray();
+    for (const auto &v : arr) {
+        bool d = false;
+        todos.push_back(fromJson(v.toObject(), date, &d));
+        done.push_back(d);
+    }
+
+    if (journalBatch)
+        *journalBatch = doc.object()["journal_batch"].toString();
+    return true;
+}
+
+bool TodoStore::writeDayFile(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                             const QString &journalBatch)
+{
+    QJsonArray arr;
+    for (int i = 0; i < todos.size(); ++i)
+        arr.append(toJson(todos[i], (i < done.size()) ? done[i] : false));
+
+    QJsonObject root;
+    root["todos"] = arr;
+    if (!journalBatch.isEmpty())
+        root["journal_batch"] = journalBatch;
+
+    QSaveFile f(filePath(date));
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(QJsonDocument(root).toJson());
+    return f.commit();
+}
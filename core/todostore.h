@@ -0,0 +1,29 @@
+#pragma once
+#include <QDate>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+#include "models.h"
+
+// ✅ Todo 檔：data/yyyy-MM-dd.todo.json
+class TodoStore
+{
+public:
+    static QString filePath(const QDate &date);
+
+    static QJsonObject toJson(const Todo &td, bool done);
+    static Todo fromJson(const QJsonObject &o, const QDate &date, bool *done = nullptr);
+
+    // 經過日快取，實際讀寫交給 DayStore。沒資料回傳 false（也算正常）
+    static bool load(const QDate &date, QVector<Todo> &todos, QVector<bool> &done);
+    // 交給 DayStore（journal 只追加 ops）；成功後更新日快取與索引
+    static bool save(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                     const QVector<QJsonObject> &ops);
+
+    // 只讀寫日檔本身；journalBatch 同 Account::readDayFile
+    static bool readDayFile(const QDate &date, QVector<Todo> &todos, QVector<bool> &done,
+                            QString *journalBatch = nullptr);
+    static bool writeDayFile(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                             const QString &journalBatch = QString());
+};
@@ -0,0 +1,136 @@
+#include "trace.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+
+// JSON 最多記這麼多筆，長時間開著也不會無限長大
+static const int kMaxEvents = 1000000;
+
+Trace& Trace::instance()
+{
+    static Trace t;
+    return t;
+}
+
+Trace::Trace()
+{
+    m_clock.start();
+}
+
+int Trace::threadIndex()
+{
+    const quintptr id = quintptr(QThread::currentThreadId());
+    auto it = m_threads.find(id);
+    if (it == m_threads.end()) it = m_threads.insert(id, m_threads.size() + 1);
+    return *it;
+}
+
+void Trace::complete(const char *name, const char *category, qint64 startUs, qint64 durationUs)
+{
+    QMutexLocker lock(&m_mutex);
+    if (m_finished) return;
+
+    ScopeStats &s = m_scopes[QByteArray::fromRawData(name, int(qstrlen(name)))];
+    s.calls++;
+    s.totalUs += durationUs;
+    s.maxUs = qMax(s.maxUs, durationUs);
+
+    if (m_events.size() >= kMaxEvents) {
+        m_dropped++;
+        return;
+    }
+    m_events.append({ name, category, 'X', threadIndex(), startUs, durationUs });
+}
+
+void Trace::count(const char *name, qint64 delta)
+{
+    const qint64 ts = nowUs();
+
+    QMutexLocker lock(&m_mutex);
+    if (m_finished) return;
+
+    qint64 &total = m_counters[QByteArray::fromRawData(name, int(qstrlen(name)))];
+    total += delta;
+
+    if (m_events.size() >= kMaxEvents) {
+        m_dropped++;
+        return;
+    }
+    m_events.append({ name, "counter", 'C', threadIndex(), ts, total });
+}
+
+static QByteArray jsonString(const char *s)
+{
+    QByteArray out = "\"";
+    for (const char *p = s; *p; ++p) {
+        if (*p == '"' || *p == '\\') out += '\\';
+        out += *p;
+    }
+    return out + '"';
+}
+
+void Trace::finish()
+{
+    if (!enabled()) return;
+
+    QMutexLocker lock(&m_mutex);
+    if (m_finished) return;
+    m_finished = true;
+
+    QString path = qEnvironmentVariable("CALENDAR_TRACE");
+    if (path == "1") path = "calendar-trace.json";
+
+    // ✅ trace_event 格式：逐行寫，不先組一棵 QJsonDocument
+    QFile f(path);
+    if (f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+        f.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        for (int i = 0; i < m_events.size(); ++i) {
+            const Event &e = m_events[i];
+            QByteArray line = "{\"name\":" + jsonString(e.name)
+                              + ",\"cat\":" + jsonString(e.category)
+                              + ",\"ph\":\"" + e.phase + "\""
+                              + ",\"pid\":" + pid
+                              + ",\"tid\":" + QByteArray::number(e.tid)
+                              + ",\"ts\":" + QByteArray::number(e.ts);
+            if (e.phase == 'X') line += ",\"dur\":" + QByteArray::number(e.value) + "}";
+            else line += ",\"args\":{\"value\":" + QByteArray::number(e.value) + "}}";
+            if (i + 1 < m_events.size()) line += ',';
+            f.write(line + '\n');
+        }
+        f.write("]}\n");
+        f.close();
+    } else {
+        qWarning().noquote() << QString("trace: cannot write %1").arg(path);
+    }
+
+    // ✅ 摘要：依總時間排序
+    QVector<QByteArray> names = m_scopes.keys().toVector();
+    std::sort(names.begin(), names.end(), [&](const QByteArray &a, const QByteArray &b){
+        return m_scopes[a].totalUs > m_scopes[b].totalUs;
+    });
+
+    qInfo().noquote() << QString("trace: %1 events -> %2%3")
+                             .arg(m_events.size()).arg(path)
+                             .arg(m_dropped ? QString(" (%1 dropped)").arg(m_dropped) : QString());
+    qInfo().noquote() << QString("%1 %2 %3 %4 %5")
+                             .arg("scope", -36).arg("calls", 8).arg("total ms", 10)
+                             .arg("avg ms", 9).arg("max ms", 9);
+    for (const QByteArray &n : names) {
+        const ScopeStats &s = m_scopes[n];
+        qInfo().noquote() << QString("%1 %2 %3 %4 %5")
+                                 .arg(QString::fromLatin1(n), -36)
+                                 .arg(s.calls, 8)
+                                 .arg(s.totalUs / 1000.0, 10, 'f', 2)
+                                 .arg(s.totalUs / 1000.0 / s.calls, 9, 'f', 3)
+                                 .arg(s.maxUs / 1000.0, 9, 'f', 2);
+    }
+
+    QVector<QByteArray> counters = m_counters.keys().toVector();
+    std::sort(counters.begin(), counters.end());
+    for (const QByteArray &n : counters)
+        qInfo().noquote() << QString("%1 %2").arg(QString::fromLatin1(n), -36).arg(m_counters[n], 8);
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+// ✅ 效能追蹤：CALENDAR_TRACE=<輸出檔> 時啟用（值為 1 寫到 calendar-trace.json）
+// TRACE_SCOPE 記一段計時、TRACE_COUNT 累加計數器；離開時呼叫 finish()
+// 寫出 Chrome trace_event JSON（chrome://tracing、Perfetto 可開）並印一張摘要表
+// 沒啟用時每個巨集只是讀一個 static bool
+class Trace
+{
+public:
+    static bool enabled()
+    {
+        static const bool on = !qEnvironmentVariableIsEmpty("CALENDAR_TRACE");
+        return on;
+    }
+    static Trace& instance();
+
+    // name / category 必須是字串常值（只存指標）
+    void complete(const char *name, const char *category, qint64 startUs, qint64 durationUs);
+    void count(const char *name, qint64 delta);
+
+    qint64 nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+
+    // 寫檔 + 摘要；可重複呼叫，只有第一次有作用
+    void finish();
+
+private:
+    Trace();
+
+    struct Event {
+        const char *name;
+        const char *category;
+        char phase;         // 'X' 區段、'C' 計數器
+        int tid;
+        qint64 ts;
+        qint64 value;       // 'X'：持續時間（us）；'C'：累計值
+    };
+    struct ScopeStats {
+        int calls = 0;
+        qint64 totalUs = 0;
+        qint64 maxUs = 0;
+    };
+
+    int threadIndex();      // 呼叫時已持有 m_mutex
+
+    QMutex m_mutex;
+    QElapsedTimer m_clock;
+    QVector<Event> m_events;
+    QHash<QByteArray, ScopeStats> m_scopes;
+    QHash<QByteArray, qint64> m_counters;
+    QHash<quintptr, int> m_threads;
+    bool m_finished = false;
+    int m_dropped = 0;      // 超過上限沒記進 JSON 的事件（摘要仍有算）
+};
+
+class TraceScope
+{
+public:
+    explicit TraceScope(const char *name, const char *category = "app")
+        : m_name(Trace::enabled() ? name : nullptr),
+          m_category(category)
+    {
+        if (m_name) m_start = Trace::instance().nowUs();
+    }
+    ~TraceScope()
+    {
+        if (!m_name) return;
+        Trace &t = Trace::instance();
+        t.complete(m_name, m_category, m_start, t.nowUs() - m_start);
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope& operator=(const TraceScope &) = delete;
+
+private:
+    const char *m_name;
+    const char *m_category;
+    qint64 m_start = 0;
+};
+
+#define CALENDAR_TRACE_JOIN2(a, b) a##b
+#define CALENDAR_TRACE_JOIN(a, b) CALENDAR_TRACE_JOIN2(a, b)
+
+#define TRACE_SCOPE(name) TraceScope CALENDAR_TRACE_JOIN(traceScope_, __LINE__)(name)
+#define TRACE_SCOPE_CAT(name, category) TraceScope CALENDAR_TRACE_JOIN(traceScope_, __LINE__)(name, category)
+#define TRACE_COUNT(name, delta) \
+    do { if (Trace::enabled()) Trace::instance().count(name, delta); } while (0)
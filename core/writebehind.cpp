@@ -0,0 +1,110 @@
+#include "writebehind.h"
+#include "daycache.h"
+#include "todostore.h"
+
+WriteBehind::WriteBehind(Done onLedger, Done onTodos)
+    : m_onLedger(std::move(onLedger)), m_onTodos(std::move(onTodos))
+{
+}
+
+void WriteBehind::putLedger(const QDate &date, const Account &account)
+{
+    m_requested++;
+
+    auto it = m_ledger.find(date);
+    if (it == m_ledger.end()) {
+        m_ledger.insert(date, account);
+        return;
+    }
+
+    // 合併：內容取最新的，journal 異動要接在前一次後面
+    Account merged = account;
+    merged.prependPendingOps(it.value());
+    it.value() = merged;
+}
+
+void WriteBehind::putTodos(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                           const QVector<QJsonObject> &ops)
+{
+    m_requested++;
+
+    PendingTodos &p = m_todos[date];
+    p.todos = todos;
+    p.done = done;
+    p.ops += ops;
+}
+
+bool WriteBehind::ledger(const QDate &date, Account &out) const
+{
+    auto it = m_ledger.constFind(date);
+    if (it == m_ledger.constEnd()) return false;
+    out = it.value();
+    out.clearPendingOps();
+    return true;
+}
+
+bool WriteBehind::todos(const QDate &date, QVector<Todo> &todos, QVector<bool> &done) const
+{
+    auto it = m_todos.constFind(date);
+    if (it == m_todos.constEnd()) return false;
+    todos = it->todos;
+    done = it->done;
+    return true;
+}
+
+void WriteBehind::writeLedger(const QDate &date, const Account &account)
+{
+    bool ok = account.saveToFile(date);
+    if (ok) {
+        m_written++;
+    } else {
+        // journal 只追加異動：這批沒寫進去，之後的索引就對不上，一定要留著重寫
+        auto it = m_ledger.find(date);
+        if (it == m_ledger.end()) m_ledger.insert(date, account);
+        else it.value().prependPendingOps(account);
+    }
+    if (m_onLedger) m_onLedger(date, ok);
+}
+
+void WriteBehind::writeTodos(const QDate &date, const PendingTodos &p)
+{
+    bool ok = TodoStore::save(date, p.todos, p.done, p.ops);
+    if (ok) {
+        m_written++;
+    } else {
+        auto it = m_todos.find(date);
+        if (it == m_todos.end()) m_todos.insert(date, p);
+        else it->ops = p.ops + it->ops;
+    }
+    if (m_onTodos) m_onTodos(date, ok);
+}
+
+void WriteBehind::flushAll()
+{
+    const QHash<QDate, Account> ledger = m_ledger;
+    const QHash<QDate, PendingTodos> todos = m_todos;
+    m_ledger.clear();
+    m_todos.clear();
+
+    for (auto it = ledger.constBegin(); it != ledger.constEnd(); ++it)
+        writeLedger(it.key(), it.value());
+    for (auto it = todos.constBegin(); it != todos.constEnd(); ++it)
+        writeTodos(it.key(), it.value());
+}
+
+void WriteBehind::flushLedgerMonth(int year, int month)
+{
+    // 先整批取出再寫：寫失敗的會放回 m_ledger，不能邊走邊改
+    QHash<QDate, Account> ledger;
+    for (auto it = m_ledger.begin(); it != m_ledger.end(); ) {
+        if (it.key().year() == year && it.key().month() == month) {
+            ledger.insert(it.key(), it.value());
+            it = m_ledger.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (auto it = ledger.constBegin(); it != ledger.constEnd(); ++it)
+        writeLedger(it.key(), it.value());
+}
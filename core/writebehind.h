@@ -0,0 +1,56 @@
+#pragma once
+#include <QDate>
+#include <QHash>
+#include <QJsonObject>
+#include <QVector>
+#include <atomic>
+#include <functional>
+
+#include "account.h"
+#include "models.h"
+
+// ✅ 延遲寫入：同一天的連續修改先合併，之後一次寫出
+// 只在儲存執行緒上使用（計數器除外）
+class WriteBehind
+{
+public:
+    using Done = std::function<void(const QDate&, bool)>;
+
+    WriteBehind(Done onLedger, Done onTodos);
+
+    void putLedger(const QDate &date, const Account &account);
+    void putTodos(const QDate &date, const QVector<Todo> &todos, const QVector<bool> &done,
+                  const QVector<QJsonObject> &ops);
+
+    // 還沒寫出的最新內容（讀檔時優先用這個）
+    bool ledger(const QDate &date, Account &out) const;
+    bool todos(const QDate &date, QVector<Todo> &todos, QVector<bool> &done) const;
+
+    void flushAll();
+    void flushLedgerMonth(int year, int month);   // 月統計前先寫出當月的記帳
+
+    int dirtyCount() const { return m_ledger.size() + m_todos.size(); }
+
+    quint64 requested() const { return m_requested.load(); }
+    quint64 written() const { return m_written.load(); }   // 只算寫成功的
+
+private:
+    struct PendingTodos {
+        QVector<Todo> todos;
+        QVector<bool> done;
+        QVector<QJsonObject> ops;
+    };
+
+    // 寫失敗的那天放回待寫（異動接在較新的前面），下次 flush 再試
+    void writeLedger(const QDate &date, const Account &account);
+    void writeTodos(const QDate &date, const PendingTodos &p);
+
+    Done m_onLedger;
+    Done m_onTodos;
+
+    QHash<QDate, Account> m_ledger;
+    QHash<QDate, PendingTodos> m_todos;
+
+    std::atomic<quint64> m_requested{0};
+    std::atomic<quint64> m_written{0};
+};